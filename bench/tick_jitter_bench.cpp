@@ -0,0 +1,139 @@
+/** @file
+ *
+ * @brief Measures the lateness of periodic callbacks relative to the timepoint grid, 
+ * for the different ways of running a periodic callback.
+ *
+ * Each variant runs a 1 ms timepoint sequence, and records for each callback how late 
+ * it is invoked relative to its scheduled timepoint. The mean, 99th percentile and 
+ * maximum lateness are reported, along with the process CPU time per tick (which for 
+ * the spinning runners includes the spinning).
+ *
+ * On Linux the @c timerfd_timer, armed once with a kernel interval, is compared with 
+ * the @c periodic_timer re-arm on each tick.
+ *
+ * Usage: @c tick_jitter_bench @c [ticks]
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <algorithm> // std::sort
+#include <chrono>
+#include <ctime> // std::clock
+#include <cstdlib> // std::atoi
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "timer/periodic_timer.hpp"
+#include "timer/periodic_timer_runner.hpp"
+#include "timer/periodic_loop.hpp"
+#include "timer/timerfd_timer.hpp"
+
+using clock_type = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+constexpr auto Period = 1ms;
+
+// records the lateness of each invocation against the grid starting at the first timepoint
+class lateness_recorder {
+public:
+  lateness_recorder(int ticks) : m_first(clock_type::now() + Period), m_ticks(ticks),
+      m_cpu_start(std::clock()) {
+    m_lateness.reserve(ticks);
+  }
+  clock_type::time_point first() const { return m_first; }
+
+  bool record() {
+    auto scheduled = m_first + static_cast<int>(m_lateness.size()) * Period;
+    m_lateness.push_back(clock_type::now() - scheduled);
+    return static_cast<int>(m_lateness.size()) < m_ticks;
+  }
+
+  void report(const char* name) {
+    using us = std::chrono::duration<double, std::micro>;
+    double cpu_us = 1e6 * static_cast<double>(std::clock() - m_cpu_start) / CLOCKS_PER_SEC;
+    std::sort(m_lateness.begin(), m_lateness.end());
+    clock_type::duration total { };
+    for (auto l : m_lateness) {
+      total += l;
+    }
+    std::cout << name << ": mean " << us(total / m_lateness.size()).count() 
+              << " us, p99 " << us(m_lateness[m_lateness.size() * 99 / 100]).count() 
+              << " us, max " << us(m_lateness.back()).count() 
+              << " us, cpu " << cpu_us / m_lateness.size() << " us per tick" << std::endl;
+  }
+
+private:
+  clock_type::time_point m_first;
+  int m_ticks;
+  std::vector<clock_type::duration> m_lateness;
+  std::clock_t m_cpu_start;
+};
+
+void bench_timer (const char* name, const chops::runner_options& opts, int ticks) {
+  chops::periodic_timer_runner runner { opts };
+  chops::periodic_timer<> timer { runner.get_io_context() };
+  runner.watch(timer);
+  lateness_recorder rec { ticks };
+  timer.start_timepoint_timer(Period, rec.first(),
+    [&rec] (std::error_code, clock_type::duration) {
+      return rec.record();
+    }
+  );
+  if (auto err = runner.start(); err) {
+    std::cerr << name << ": runner start failed: " << err.message() << std::endl;
+    return;
+  }
+  runner.join();
+  rec.report(name);
+}
+
+#ifdef __linux__
+void bench_timerfd (const char* name, int ticks) {
+  asio::io_context ioc { 1 };
+  chops::timerfd_timer<> timer { ioc };
+  lateness_recorder rec { ticks };
+  if (auto err = timer.start_timepoint_timer(Period, rec.first(),
+        [&rec] (std::error_code, clock_type::duration) {
+          return rec.record();
+        }); err) {
+    std::cerr << name << ": start failed: " << err.message() << std::endl;
+    return;
+  }
+  ioc.run();
+  rec.report(name);
+}
+#endif
+
+void bench_loop (const char* name, int ticks) {
+  chops::periodic_loop<> loop;
+  lateness_recorder rec { ticks };
+  loop.run(Period, rec.first(), [&rec] (std::error_code, clock_type::duration) {
+      return rec.record();
+    }
+  );
+  rec.report(name);
+}
+
+int main (int argc, char* argv[]) {
+  int ticks = (argc > 1) ? std::atoi(argv[1]) : 5000;
+
+  std::cout << "Ticks per run: " << ticks << ", period 1 ms" << std::endl;
+
+  bench_timer("periodic_timer, blocking runner   ", chops::runner_options { }, ticks);
+  bench_timer("periodic_timer, hybrid runner     ",
+              chops::runner_options { .mode = chops::run_mode::hybrid }, ticks);
+  bench_timer("periodic_timer, spin runner       ",
+              chops::runner_options { .mode = chops::run_mode::spin }, ticks);
+#ifdef __linux__
+  bench_timerfd("timerfd_timer, blocking           ", ticks);
+#endif
+  bench_loop ("periodic_loop, clock_nanosleep    ", ticks);
+  return 0;
+}
@@ -0,0 +1,87 @@
+/** @file
+ *
+ * @brief Measures the per-tick overhead of @c periodic_timer for different 
+ * @c periodic_timer_runner configurations.
+ *
+ * A duration timer with a zero period is re-armed immediately after each callback, so 
+ * the time per tick is the cost of the timer wait, the Asio timer queue and scheduler, 
+ * and the handler, without any actual waiting.
+ *
+ * Usage: @c tick_overhead_bench @c [ticks]
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <chrono>
+#include <cstdlib> // std::atoi
+#include <iostream>
+#include <system_error>
+
+#include "timer/periodic_timer.hpp"
+#include "timer/periodic_timer_runner.hpp"
+
+constexpr int Repetitions = 5;
+
+using direct_timer = chops::periodic_timer<std::chrono::steady_clock, void, 0u,
+                                           asio::wait_traits<std::chrono::steady_clock>,
+                                           asio::io_context::executor_type>;
+
+// returns nanoseconds per tick
+template <typename Timer>
+double run_ticks (const chops::runner_options& opts, int ticks) {
+  using clock = std::chrono::steady_clock;
+
+  chops::periodic_timer_runner runner { opts };
+  Timer timer { runner.get_io_context() };
+  int count = 0;
+  // started before the runner, as required for the single-threaded configuration
+  timer.start_duration_timer(clock::duration::zero(),
+    [&count, ticks] (std::error_code, clock::duration) {
+      return ++count < ticks;
+    }
+  );
+  auto start = clock::now();
+  if (auto err = runner.start(); err) {
+    std::cerr << "Runner start failed: " << err.message() << std::endl;
+    std::exit(1);
+  }
+  runner.join();
+  std::chrono::duration<double, std::nano> elap = clock::now() - start;
+  return elap.count() / count;
+}
+
+template <typename Timer = chops::periodic_timer<>>
+void bench (const char* name, const chops::runner_options& opts, int ticks) {
+  double best = run_ticks<Timer>(opts, ticks);
+  for (int i = 1; i < Repetitions; ++i) {
+    double t = run_ticks<Timer>(opts, ticks);
+    best = (t < best) ? t : best;
+  }
+  std::cout << name << ": " << best << " ns per tick" << std::endl;
+}
+
+int main (int argc, char* argv[]) {
+  int ticks = (argc > 1) ? std::atoi(argv[1]) : 200000;
+
+  std::cout << "Ticks per run: " << ticks << ", best of " << Repetitions << " runs" << std::endl;
+
+  bench("Blocking, concurrency hint 1          ",
+        chops::runner_options { }, ticks);
+  bench("Blocking, single-threaded (unsafe)    ",
+        chops::runner_options { .concurrency_hint = chops::single_threaded_hint }, ticks);
+  bench("Busy poll, concurrency hint 1         ",
+        chops::runner_options { .mode = chops::run_mode::busy_poll }, ticks);
+  bench("Busy poll, single-threaded (unsafe)   ",
+        chops::runner_options { .concurrency_hint = chops::single_threaded_hint,
+                                .mode = chops::run_mode::busy_poll }, ticks);
+  bench<direct_timer>("Busy poll, unsafe, io_context executor",
+        chops::runner_options { .concurrency_hint = chops::single_threaded_hint,
+                                .mode = chops::run_mode::busy_poll }, ticks);
+  return 0;
+}
@@ -0,0 +1,90 @@
+/** @file
+ *
+ * @brief Computation of a start time point aligned to wall clock boundaries, so that
+ * timers on different hosts fire together.
+ *
+ * Timers started at arbitrary times fire at arbitrary phases of their period. When
+ * results from many hosts are aggregated per interval, it is better if e.g. every 1
+ * second timer fires on the second boundary, and every 1 minute timer on :00.
+ * @c aligned_time_point computes the next time point that is a whole multiple of the
+ * period since the wall clock epoch (plus an optional offset), expressed on the timer
+ * clock:
+ *
+ * @code
+ *   chops::periodic_timer<> timer { ioc };
+ *   timer.start_timepoint_timer(1s, chops::aligned_time_point(1s), func);
+ * @endcode
+ *
+ * The wall clock is only read once, to map the boundary onto the timer clock. The
+ * timepoint grid then follows the timer clock (@c std::chrono::steady_clock by default),
+ * so that small wall clock adjustments (e.g. NTP slewing or a step) don't disturb a
+ * running timer. Hosts with synchronized wall clocks stay aligned to within the
+ * difference in their steady clock rates, and a long running timer can be re-aligned
+ * by restarting it with a new @c aligned_time_point.
+ *
+ * The result can be passed as the @c when parameter of any of the timers in this
+ * library, e.g. @c periodic_loop::run or @c timerfd_timer::start_timepoint_timer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef ALIGNED_START_HPP_INCLUDED
+#define ALIGNED_START_HPP_INCLUDED
+
+#include <chrono>
+#include <type_traits> // std::is_same_v, std::common_type_t
+
+namespace chops {
+
+/**
+ * Return the next time point after now that is a whole multiple of the period since
+ * the wall clock epoch, plus an offset, mapped onto the timer clock.
+ *
+ * @param period Alignment interval, normally the period of the timer. Must be greater
+ * than zero.
+ *
+ * @param offset Phase within the period, e.g. 15s to fire at :15 of each minute.
+ * Defaults to zero.
+ *
+ * @return Time point on @c Clock, at most one period in the future.
+ */
+template <typename Clock = std::chrono::steady_clock,
+          typename WallClock = std::chrono::system_clock,
+          typename Rep, typename Period>
+typename Clock::time_point aligned_time_point(const std::chrono::duration<Rep, Period>& period,
+        const typename WallClock::duration& offset = WallClock::duration::zero()) {
+  using dur_type = std::common_type_t<typename WallClock::duration,
+                                      std::chrono::duration<Rep, Period>>;
+
+  // time since the last boundary, always in [0, period)
+  auto since_boundary = [&period, &offset] (const typename WallClock::time_point& wall) {
+    dur_type phase { (wall.time_since_epoch() - offset) % dur_type(period) };
+    return phase < dur_type::zero() ? phase + dur_type(period) : phase;
+  };
+
+  if constexpr (std::is_same_v<Clock, WallClock>) {
+    auto now_time { WallClock::now() };
+    return std::chrono::time_point_cast<typename Clock::duration>(
+             now_time + (dur_type(period) - since_boundary(now_time)));
+  }
+  else {
+    // bracket the wall clock read with timer clock reads, and map it onto the midpoint
+    auto before { Clock::now() };
+    auto wall { WallClock::now() };
+    auto after { Clock::now() };
+    auto mid { before + (after - before) / 2 };
+    return mid + std::chrono::duration_cast<typename Clock::duration>(
+                   dur_type(period) - since_boundary(wall));
+  }
+}
+
+} // end namespace
+
+#endif
+
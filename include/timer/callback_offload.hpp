@@ -0,0 +1,228 @@
+/** @file
+ *
+ * @brief Function object adaptor that runs @c periodic_timer callbacks on a separate
+ * executor, such as an @c asio::thread_pool.
+ *
+ * A slow callback blocks the thread running the @c io_context, which delays every other
+ * timer serviced by the same @c io_context. Wrapping the callback with @c offload keeps
+ * the timer waits and re-arms on the timer executor, while the application function
+ * object is dispatched to the callback executor.
+ *
+ * Since the timer no longer waits for the application function object, an
+ * @c overlap_policy specifies what happens when a timer expires while the previous
+ * invocation is still running:
+ *
+ * - @c skip drops the invocation for that expiry.
+ * - @c queue runs one invocation per expiry, one after the other, each with the elapsed
+ *   time of its own expiry.
+ * - @c concurrent runs every invocation as soon as possible, possibly concurrently on
+ *   different threads of the callback executor. The function object must be safe to
+ *   invoke concurrently.
+ *
+ * When the application function object returns @c false, the timer stops on its next
+ * expiry (the timer cannot be told synchronously, since the function object runs on a
+ * different executor).
+ *
+ * A cancelled timer results in the function object being invoked with an "operation
+ * aborted" error code, after any queued invocations. With the @c concurrent policy the
+ * notification may run concurrently with a previous invocation. The return value of the
+ * notification is ignored, and once it has been delivered the adaptor can be used to
+ * start a timer again.
+ *
+ * @code
+ *   asio::thread_pool pool { 4 };
+ *   timer.start_timepoint_timer(10ms, chops::offload(pool.get_executor(),
+ *     [] (std::error_code err, std::chrono::steady_clock::duration elap) {
+ *       // heavy processing
+ *       return true;
+ *     }, chops::overlap_policy::queue)
+ *   );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CALLBACK_OFFLOAD_HPP_INCLUDED
+#define CALLBACK_OFFLOAD_HPP_INCLUDED
+
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+
+#include <atomic>
+#include <memory> // std::shared_ptr, std::make_shared
+#include <system_error>
+#include <type_traits> // std::decay_t
+#include <utility> // std::move, std::forward
+
+namespace chops {
+
+/**
+ * Specifies what happens when a timer expires while the previous offloaded invocation
+ * of the application function object is still running.
+ */
+enum class overlap_policy { skip, queue, concurrent };
+
+template <typename Executor, typename F>
+class offloaded_callback {
+private:
+
+  struct shared_state {
+    shared_state(const Executor& ex, F&& func, overlap_policy policy) :
+        m_ex(ex), m_strand(ex), m_func(std::move(func)), m_policy(policy),
+        m_pending(0), m_finished(false) { }
+
+    Executor          m_ex;
+    // serializes the invocations for queue
+    asio::strand<Executor> m_strand;
+    F                 m_func;
+    overlap_policy    m_policy;
+    // number of requested invocations, including the running one, plus a flag bit for 
+    // a requested "operation aborted" notification; only used for skip
+    std::atomic<int>  m_pending;
+    std::atomic<bool> m_finished;
+  };
+
+  std::shared_ptr<shared_state> m_state;
+
+  static constexpr int aborted_flag = 1 << 30;
+
+private:
+  template <typename D>
+  static void invoke(shared_state& st, const std::error_code& err, const D& elap) {
+    if (err) {
+      // the end of the timer run, a restarted timer starts afresh
+      st.m_func(err, elap);
+      st.m_finished.store(false, std::memory_order_release);
+      return;
+    }
+    if (st.m_finished.load(std::memory_order_acquire)) {
+      return; // app is finished, don't call into it again
+    }
+    if (!st.m_func(err, elap)) {
+      st.m_finished.store(true, std::memory_order_release);
+    }
+  }
+  // for skip, runs the requested invocation, then the aborted notification if it was
+  // requested meanwhile
+  template <typename D>
+  static void drain(std::shared_ptr<shared_state> st, D elap) {
+    int cur { st->m_pending.load(std::memory_order_acquire) };
+    for (;;) {
+      // the aborted notification is always the last request
+      int done { 1 };
+      if (cur == (aborted_flag | 1)) {
+        invoke(*st, std::error_code(asio::error::operation_aborted), elap);
+        done |= aborted_flag;
+      }
+      else {
+        invoke(*st, std::error_code(), elap);
+      }
+      cur = st->m_pending.fetch_sub(done, std::memory_order_acq_rel) - done;
+      if (cur == 0) {
+        return;
+      }
+    }
+  }
+
+public:
+
+  /**
+   * Construct the adaptor, normally through the @c offload function.
+   *
+   * @param ex Executor on which the application function object is invoked.
+   *
+   * @param func Application function object, with the same signature as required by
+   * @c periodic_timer.
+   *
+   * @param policy Overlap policy.
+   */
+  offloaded_callback(const Executor& ex, F&& func, overlap_policy policy) :
+    m_state(std::make_shared<shared_state>(ex, std::move(func), policy)) { }
+
+  /**
+   * Invoked by @c periodic_timer on the timer executor, dispatches the application
+   * function object to the callback executor.
+   *
+   * @return @c false if the application function object has returned @c false.
+   */
+  template <typename D>
+  bool operator()(const std::error_code& err, const D& elap) const {
+    if (err == asio::error::operation_aborted) {
+      switch (m_state->m_policy) {
+        case overlap_policy::skip:
+          if (m_state->m_pending.fetch_add(aborted_flag | 1, std::memory_order_acq_rel) == 0) {
+            asio::post(m_state->m_ex, [st = m_state, elap] { drain(std::move(st), elap); } );
+          }
+          break;
+        case overlap_policy::queue:
+          asio::post(m_state->m_strand, [st = m_state, err, elap] { invoke(*st, err, elap); } );
+          break;
+        case overlap_policy::concurrent:
+          asio::post(m_state->m_ex, [st = m_state, err, elap] { invoke(*st, err, elap); } );
+          break;
+      }
+      return false;
+    }
+    if (m_state->m_finished.load(std::memory_order_acquire)) {
+      return false;
+    }
+    switch (m_state->m_policy) {
+      case overlap_policy::skip: {
+        int idle { 0 };
+        if (m_state->m_pending.compare_exchange_strong(idle, 1, std::memory_order_acq_rel)) {
+          asio::post(m_state->m_ex, [st = m_state, elap] { drain(std::move(st), elap); } );
+        }
+        break;
+      }
+      case overlap_policy::queue:
+        asio::post(m_state->m_strand,
+                   [st = m_state, elap] { invoke(*st, std::error_code(), elap); } );
+        break;
+      case overlap_policy::concurrent:
+        asio::post(m_state->m_ex, [st = m_state, err, elap] { invoke(*st, err, elap); } );
+        break;
+    }
+    return true;
+  }
+
+  /**
+   * Return @c true if the application function object has returned @c false.
+   */
+  bool is_finished() const noexcept {
+    return m_state->m_finished.load(std::memory_order_acquire);
+  }
+};
+
+/**
+ * Wrap an application function object so that it is invoked on a separate executor,
+ * while the @c periodic_timer waits and re-arms stay on the timer executor.
+ *
+ * @param ex Executor on which the application function object is invoked, e.g.
+ * @c asio::thread_pool::executor_type.
+ *
+ * @param func Application function object, with the same signature as required by
+ * @c periodic_timer.
+ *
+ * @param policy What to do when the timer expires while the previous invocation is
+ * still running, defaults to @c overlap_policy::skip.
+ *
+ * @return A function object to be passed to one of the @c periodic_timer @c start
+ * methods.
+ */
+template <typename Executor, typename F>
+auto offload(const Executor& ex, F&& func, overlap_policy policy = overlap_policy::skip) {
+  using func_type = std::decay_t<F>;
+  return offloaded_callback<Executor, func_type>(ex, func_type(std::forward<F>(func)), policy);
+}
+
+} // end namespace
+
+#endif
+
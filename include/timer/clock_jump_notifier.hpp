@@ -0,0 +1,188 @@
+/** @file
+ *
+ * @brief Linux notification of system clock changes, through a @c timerfd armed with
+ * @c TFD_TIMER_CANCEL_ON_SET.
+ *
+ * A timer on @c std::chrono::system_clock waiting for a timepoint is delayed by a
+ * backward step of the clock (e.g. by NTP, or an administrator setting the time), since
+ * the timepoint is now further away. @c periodic_timer detects clock jumps on expiry
+ * (see @c periodic_timer::set_clock_jump_threshold), but can only be woken early when it
+ * is told about the jump. @c clock_jump_notifier invokes a function object whenever
+ * the kernel reports a discontinuous change of @c CLOCK_REALTIME, which can then call
+ * @c periodic_timer::clock_jumped:
+ *
+ * @code
+ *   chops::clock_jump_notifier notifier { ioc };
+ *   notifier.start([&timer] (std::error_code err) {
+ *       if (!err) {
+ *         timer.clock_jumped();
+ *       }
+ *       return !err;
+ *     }
+ *   );
+ * @endcode
+ *
+ * The function object has the signature:
+ * @code
+ *   bool (std::error_code);
+ * @endcode
+ * It is invoked without an error for each clock change, and continues to be invoked as
+ * long as it returns @c true. A @c cancel results in an "operation aborted" error code.
+ *
+ * As with @c timerfd_timer, the @c start and @c cancel methods must be called from the
+ * thread running the @c io_context, or before it is run.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CLOCK_JUMP_NOTIFIER_HPP_INCLUDED
+#define CLOCK_JUMP_NOTIFIER_HPP_INCLUDED
+
+#ifdef __linux__
+
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+
+#include <cerrno>
+#include <cstdint> // std::uint64_t
+#include <limits>
+#include <system_error>
+#include <utility> // std::move, std::forward
+
+#include <sys/timerfd.h>
+#include <unistd.h> // read
+
+namespace chops {
+
+class clock_jump_notifier {
+private:
+  asio::posix::stream_descriptor m_fd;
+  unsigned m_gen;
+  bool m_cancelled;
+
+private:
+  static std::error_code last_error() {
+    return std::error_code(errno, std::system_category());
+  }
+
+  // an expiry that is never reached, the timerfd is only used for the cancel on set
+  std::error_code arm() {
+    itimerspec spec { };
+    spec.it_value.tv_sec = std::numeric_limits<time_t>::max() / 2;
+    if (::timerfd_settime(m_fd.native_handle(), TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET,
+                          &spec, nullptr) != 0) {
+      return last_error();
+    }
+    return std::error_code();
+  }
+
+  template <typename F>
+  void wait(unsigned gen, F&& func) {
+    m_fd.async_wait(asio::posix::stream_descriptor::wait_read,
+      [gen, f = std::move(func), this] (const std::error_code& err) mutable {
+        handler_impl(gen, err, std::move(f));
+      }
+    );
+  }
+
+  template <typename F>
+  void handler_impl(unsigned gen, std::error_code err, F&& func) {
+    if (gen != m_gen) {
+      func(std::error_code(asio::error::operation_aborted));
+      return; // handler from a previous start
+    }
+    if (m_cancelled) {
+      func(std::error_code(asio::error::operation_aborted));
+      return;
+    }
+    if (!err) {
+      std::uint64_t expirations { 0u };
+      if (::read(m_fd.native_handle(), &expirations, sizeof(expirations)) < 0) {
+        if (errno == EAGAIN) {
+          wait(gen, std::forward<F>(func)); // spurious wake-up
+          return;
+        }
+        if (errno != ECANCELED) {
+          err = last_error();
+        }
+      }
+    }
+    if (!err) {
+      err = arm(); // the timerfd stays cancelled until re-armed
+    }
+    if (!func(err) || err) {
+      return;
+    }
+    if (gen != m_gen) {
+      return; // restarted from within the function object
+    }
+    if (m_cancelled) { // cancelled from within the function object
+      func(std::error_code(asio::error::operation_aborted));
+      return;
+    }
+    wait(gen, std::forward<F>(func));
+  }
+
+public:
+
+  /**
+   * Construct a @c clock_jump_notifier, creating the @c timerfd.
+   *
+   * @param ioc @c io_context whose reactor waits on the @c timerfd.
+   *
+   * @throw std::system_error if the @c timerfd cannot be created.
+   */
+  explicit clock_jump_notifier(asio::io_context& ioc) : m_fd(ioc), m_gen(0u), m_cancelled(false) {
+    int fd { ::timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC) };
+    if (fd < 0) {
+      throw std::system_error(last_error(), "timerfd_create");
+    }
+    m_fd.assign(fd);
+  }
+
+  clock_jump_notifier(const clock_jump_notifier&) = delete;
+  clock_jump_notifier& operator=(const clock_jump_notifier&) = delete;
+
+  /**
+   * Start watching for clock changes. A previous start is cancelled, with "operation
+   * aborted" notification.
+   *
+   * @param func Function object to be invoked on each clock change.
+   *
+   * @return An error if the @c timerfd could not be armed.
+   */
+  template <typename F>
+  std::error_code start(F&& func) {
+    m_fd.cancel();
+    if (auto err { arm() }; err) {
+      return err;
+    }
+    ++m_gen;
+    m_cancelled = false;
+    wait(m_gen, std::forward<F>(func));
+    return std::error_code();
+  }
+
+  /**
+   * Stop watching for clock changes. The function object is invoked with an "operation
+   * aborted" error code.
+   */
+  void cancel() {
+    m_cancelled = true;
+    m_fd.cancel();
+  }
+};
+
+} // end namespace
+
+#endif // __linux__
+
+#endif
+
@@ -0,0 +1,160 @@
+/** @file
+ *
+ * @brief Linux clocks for @c CLOCK_BOOTTIME and @c CLOCK_TAI, with Asio wait traits, for
+ * use with @c periodic_timer, @c periodic_loop and @c timerfd_timer.
+ *
+ * @c boottime_clock is a monotonic clock that keeps counting while the system is
+ * suspended, unlike @c std::chrono::steady_clock (@c CLOCK_MONOTONIC), which stops. A
+ * timepoint grid on @c boottime_clock stays aligned with real elapsed time across a laptop
+ * or VM suspend.
+ *
+ * @c tai_clock is International Atomic Time, which has no leap seconds. Unlike
+ * @c std::chrono::system_clock (@c CLOCK_REALTIME), it is not stepped back when a leap
+ * second is inserted. The kernel derives @c CLOCK_TAI from @c CLOCK_REALTIME and the TAI
+ * offset set by the time daemon (e.g. chrony or ptp4l); if no offset has been set the two
+ * clocks are equal. It still follows steps of @c CLOCK_REALTIME, so it is not steady.
+ * Note that this is not @c std::chrono::tai_clock, which is computed from
+ * @c system_clock and a leap second table.
+ *
+ * Asio timers wait through the reactor using relative durations, measured on
+ * @c CLOCK_MONOTONIC, which does not advance during a suspend. An expiry that is reached
+ * while suspended would then be noticed late, by up to the time spent suspended.
+ * @c capped_wait_traits limits each wait of the reactor to a maximum, after which the
+ * expiry is compared against the clock again, bounding the delay after a resume or a
+ * clock step. The @c boottime_periodic_timer and @c tai_periodic_timer aliases use them:
+ *
+ * @code
+ *   chops::boottime_periodic_timer timer { ioc };
+ *   // a resume shows up as a single clock jump notification, instead of a burst of
+ *   // callbacks for the timepoints missed while suspended
+ *   timer.set_clock_jump_threshold(1s);
+ *   timer.start_timepoint_timer(100ms, [] (std::error_code err, auto elap) {
+ *       // ...
+ *       return err != asio::error::operation_aborted;
+ *     }
+ *   );
+ * @endcode
+ *
+ * A timepoint timer that falls behind invokes its callback for each missed timepoint
+ * (see @c periodic_timer). After a long suspend that is a catch-up burst; with a clock
+ * jump threshold the suspend is reported as a @c chops::timer_errc::clock_jump instead
+ * (@c boottime_clock drifts from @c steady_clock by the time spent suspended), and the
+ * grid is re-anchored.
+ *
+ * Both clocks are only available on Linux.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CLOCKS_HPP_INCLUDED
+#define CLOCKS_HPP_INCLUDED
+
+#ifdef __linux__
+
+#include <algorithm> // std::min
+#include <chrono>
+#include <cstdint> // std::intmax_t
+
+#include <time.h> // clock_gettime
+
+#include "timer/posix_clock.hpp"
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+namespace detail {
+
+template <clockid_t Id>
+std::chrono::nanoseconds posix_now() noexcept {
+  timespec ts { };
+  ::clock_gettime(Id, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+} // end detail namespace
+
+/**
+ * A clock reading @c CLOCK_BOOTTIME: monotonic, and counting through system suspend.
+ */
+struct boottime_clock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<boottime_clock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept {
+    return time_point(detail::posix_now<CLOCK_BOOTTIME>());
+  }
+};
+
+/**
+ * A clock reading @c CLOCK_TAI: wall clock time without leap second steps.
+ */
+struct tai_clock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<tai_clock>;
+  static constexpr bool is_steady = false;
+
+  static time_point now() noexcept {
+    return time_point(detail::posix_now<CLOCK_TAI>());
+  }
+};
+
+/**
+ * Asio wait traits limiting each reactor wait to @c MaxWaitMs milliseconds, for clocks
+ * that can advance without @c CLOCK_MONOTONIC advancing with them.
+ *
+ * A shorter maximum wait bounds the lateness after a resume or clock step more tightly,
+ * at the cost of an extra reactor wake-up for each maximum wait in a long interval.
+ */
+template <typename Clock, std::intmax_t MaxWaitMs = 100>
+struct capped_wait_traits {
+  static constexpr std::chrono::milliseconds max_wait { MaxWaitMs };
+
+  static typename Clock::duration to_wait_duration(const typename Clock::duration& d) {
+    return std::min<typename Clock::duration>(d, max_wait);
+  }
+
+  static typename Clock::duration to_wait_duration(const typename Clock::time_point& t) {
+    return to_wait_duration(t - Clock::now());
+  }
+};
+
+namespace detail {
+
+template <>
+struct posix_clock<boottime_clock> {
+  static constexpr bool available = true;
+  static constexpr bool timerfd = true;
+  static constexpr clockid_t id = CLOCK_BOOTTIME;
+};
+
+template <>
+struct posix_clock<tai_clock> {
+  static constexpr bool available = true;
+  static constexpr bool timerfd = false;
+  static constexpr clockid_t id = CLOCK_TAI;
+};
+
+} // end detail namespace
+
+using boottime_periodic_timer =
+    periodic_timer<boottime_clock, void, 0u, capped_wait_traits<boottime_clock>>;
+using tai_periodic_timer =
+    periodic_timer<tai_clock, void, 0u, capped_wait_traits<tai_clock>>;
+
+} // end namespace
+
+#endif // __linux__
+
+#endif
+
@@ -0,0 +1,217 @@
+/** @file
+ *
+ * @brief A watchdog timer whose deadline is pushed out by an atomic store, re-arming
+ * the Asio timer lazily only when the pending wait expires.
+ *
+ * A liveness watchdog (e.g. a connection that must receive a packet at least every
+ * 5 seconds) built from a @c periodic_timer or an Asio timer is restarted on each
+ * activity, which cancels the pending wait, completes a handler, and re-programs the
+ * timer queue for every packet. @c deadline_timer instead keeps the deadline in an
+ * atomic: @c kick only stores a new deadline, from any thread, and costs a clock read
+ * and a store. The pending wait still expires at the old deadline, and the handler then
+ * re-arms for the stored deadline if it is in the future. The number of Asio waits is
+ * bounded by the number of timeouts elapsed, not by the number of kicks.
+ *
+ * @code
+ *   chops::deadline_timer<> watchdog { ioc };
+ *   watchdog.start(5s, [] (std::error_code err, std::chrono::steady_clock::duration idle) {
+ *       if (!err) {
+ *         // nothing received for idle, close the connection
+ *       }
+ *       return false;
+ *     }
+ *   );
+ *   // for each packet received, on any thread
+ *   watchdog.kick();
+ * @endcode
+ *
+ * The function object has the signature:
+ * @code
+ *   bool (std::error_code, duration);
+ * @endcode
+ * It is invoked when the deadline passes without a kick, with the time since the last
+ * kick (or the start). Returning @c true continues watching, with a new deadline one
+ * timeout later; returning @c false finishes the timer. A @c cancel results in an
+ * "operation aborted" error code.
+ *
+ * Since the pending wait is only re-armed when it expires, a kick can only extend the
+ * deadline, not bring it closer.
+ *
+ * As with @c timerfd_timer, the @c start and @c cancel methods must be called from the
+ * thread running the @c io_context, or before it is run, while @c kick can be called
+ * from any thread. The application must keep the @c deadline_timer alive until its
+ * handlers have run.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef DEADLINE_TIMER_HPP_INCLUDED
+#define DEADLINE_TIMER_HPP_INCLUDED
+
+#include "asio/any_io_executor.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/wait_traits.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <utility> // std::move, std::forward
+
+namespace chops {
+
+template <typename Clock = std::chrono::steady_clock,
+          typename WaitTraits = asio::wait_traits<Clock>,
+          typename Executor = asio::any_io_executor>
+class deadline_timer {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+  using executor_type = Executor;
+
+private:
+  asio::basic_waitable_timer<Clock, WaitTraits, Executor> m_timer;
+  std::atomic<time_point> m_deadline;
+  // read by kick on any thread
+  std::atomic<duration> m_timeout;
+  unsigned m_gen;
+  bool m_cancelled;
+
+private:
+  template <typename F>
+  void wait(unsigned gen, const time_point& expiry, F&& func) {
+    m_timer.expires_at(expiry);
+    m_timer.async_wait( [gen, f = std::move(func), this] (const std::error_code& err) mutable {
+        handler_impl(gen, err, std::move(f));
+      }
+    );
+  }
+
+  template <typename F>
+  void handler_impl(unsigned gen, const std::error_code& err, F&& func) {
+    time_point now_time { Clock::now() };
+    time_point deadline { m_deadline.load(std::memory_order_relaxed) };
+    duration timeout { m_timeout.load(std::memory_order_relaxed) };
+    if (gen != m_gen) {
+      func(std::error_code(asio::error::operation_aborted), now_time - (deadline - timeout));
+      return; // handler from a previous start
+    }
+    if (err || m_cancelled) {
+      func((err ? err : std::error_code(asio::error::operation_aborted)),
+           now_time - (deadline - timeout));
+      return;
+    }
+    if (deadline > now_time) {
+      wait(gen, deadline, std::forward<F>(func)); // kicked since the wait was armed
+      return;
+    }
+    if (!func(std::error_code(), now_time - (deadline - timeout))) {
+      return;
+    }
+    if (gen != m_gen) {
+      return; // restarted from within the function object
+    }
+    if (m_cancelled) { // cancelled from within the function object
+      func(std::error_code(asio::error::operation_aborted), Clock::now() - now_time);
+      return;
+    }
+    // a kick during the callback is kept, otherwise a full timeout from now
+    time_point next { now_time + timeout };
+    time_point expected { deadline };
+    if (!m_deadline.compare_exchange_strong(expected, next, std::memory_order_relaxed)) {
+      next = expected;
+    }
+    wait(gen, next, std::forward<F>(func));
+  }
+
+public:
+
+  /**
+   * Construct a @c deadline_timer with an @c io_context.
+   *
+   * @param ioc @c io_context for asynchronous processing.
+   */
+  explicit deadline_timer(asio::io_context& ioc) :
+      m_timer(ioc), m_deadline(time_point::max()), m_timeout(duration::zero()),
+      m_gen(0u), m_cancelled(false) { }
+
+  /**
+   * Construct a @c deadline_timer with an executor.
+   *
+   * @param ex Executor for asynchronous processing.
+   */
+  explicit deadline_timer(const executor_type& ex) :
+      m_timer(ex), m_deadline(time_point::max()), m_timeout(duration::zero()),
+      m_gen(0u), m_cancelled(false) { }
+
+  deadline_timer(const deadline_timer&) = delete;
+  deadline_timer& operator=(const deadline_timer&) = delete;
+
+  /**
+   * Start watching, with a deadline one timeout from now. A previous start is cancelled,
+   * with "operation aborted" notification.
+   *
+   * @param timeout Time allowed between kicks.
+   *
+   * @param func Function object to be invoked when the deadline passes.
+   */
+  template <typename F>
+  void start(const duration& timeout, F&& func) {
+    m_timer.cancel();
+    ++m_gen;
+    m_cancelled = false;
+    m_timeout.store(timeout, std::memory_order_relaxed);
+    time_point deadline { Clock::now() + timeout };
+    m_deadline.store(deadline, std::memory_order_relaxed);
+    wait(m_gen, deadline, std::forward<F>(func));
+  }
+
+  /**
+   * Push the deadline out to one timeout from now. Only an atomic store, no timer
+   * operation is performed. Can be called from any thread.
+   */
+  void kick() noexcept {
+    m_deadline.store(Clock::now() + m_timeout.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  }
+
+  /**
+   * Push the deadline out to a specified time point, e.g. from a time stamp already
+   * read by the caller. A time point earlier than the pending wait takes effect when
+   * the pending wait expires. Can be called from any thread.
+   *
+   * @param deadline New deadline.
+   */
+  void kick(const time_point& deadline) noexcept {
+    m_deadline.store(deadline, std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the current deadline, @c time_point::max() before the first start.
+   */
+  time_point get_deadline() const noexcept {
+    return m_deadline.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Cancel the timer. The function object will be called with an "operation aborted"
+   * error code.
+   */
+  void cancel() {
+    m_cancelled = true;
+    m_timer.cancel();
+  }
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,165 @@
+/** @file
+ *
+ * @brief Coalesce a burst of events into one function object invocation after a quiet
+ * period, using a single @c periodic_timer.
+ *
+ * Events such as configuration file changes or UI updates often arrive in bursts of
+ * thousands, and only the state after the burst matters. Starting (or restarting) a
+ * timer for each event loads the Asio timer queue with one operation per event.
+ * @c debouncer instead records each event with a clock read and atomic stores, and only
+ * starts its timer for the first event of a burst. When the timer expires before the
+ * quiet period has passed since the latest event, it is re-armed for the remainder
+ * (through the delay returning callback of @c periodic_timer), so a burst costs a
+ * constant number of timer operations regardless of its size:
+ *
+ * @code
+ *   chops::debouncer<> reload { ioc, 200ms, [] (std::size_t events) {
+ *       // re-read the configuration once, after events changes
+ *     }
+ *   };
+ *   // for each file change notification, on any thread
+ *   reload.notify();
+ * @endcode
+ *
+ * The function object has either of the signatures:
+ * @code
+ *   void (std::size_t);
+ *   void ();
+ * @endcode
+ * and is invoked from the @c io_context with the number of events coalesced. It is
+ * stored inside the @c debouncer (see @c timer/inline_function.hpp), and must fit in the
+ * @c Capacity template parameter.
+ *
+ * @c notify can be called from any thread, including from within the function object, in
+ * which case the new event is delivered after another quiet period. The application must
+ * keep the @c debouncer alive until its timer has finished.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef DEBOUNCER_HPP_INCLUDED
+#define DEBOUNCER_HPP_INCLUDED
+
+#include "asio/io_context.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <optional>
+#include <system_error>
+#include <type_traits> // std::is_invocable_v
+#include <utility> // std::forward
+
+#include "timer/inline_function.hpp"
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+template <typename Clock = std::chrono::steady_clock, std::size_t Capacity = 64u>
+class debouncer {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+private:
+  periodic_timer<Clock> m_timer;
+  inline_function<void (std::size_t), Capacity> m_func;
+  duration m_quiet;
+  std::atomic<time_point> m_last;
+  std::atomic<std::size_t> m_events;
+  std::size_t m_delivered; // only accessed by the timer callback
+  std::atomic<bool> m_pending;
+
+private:
+  std::optional<duration> expired(const std::error_code& err) {
+    if (err) {
+      m_pending.store(false, std::memory_order_release);
+      return std::nullopt; // cancelled
+    }
+    time_point now_time { Clock::now() };
+    time_point last { m_last.load(std::memory_order_acquire) };
+    if (now_time - last < m_quiet) {
+      return (last + m_quiet) - now_time; // still in the burst, lazy re-arm
+    }
+    std::size_t events { m_events.load(std::memory_order_acquire) };
+    m_func(events - m_delivered);
+    m_delivered = events;
+    // an event from here on starts the timer again, unless this callback keeps it
+    m_pending.store(false, std::memory_order_release);
+    if (m_events.load(std::memory_order_acquire) != events &&
+        !m_pending.exchange(true, std::memory_order_acq_rel)) {
+      return m_quiet;
+    }
+    return std::nullopt;
+  }
+
+public:
+
+  /**
+   * Construct a @c debouncer.
+   *
+   * @param ioc @c io_context for asynchronous processing.
+   *
+   * @param quiet Time without events before the function object is invoked.
+   *
+   * @param func Function object to be invoked after each burst of events.
+   */
+  template <typename F>
+  debouncer(asio::io_context& ioc, const duration& quiet, F&& func) :
+      m_timer(ioc), m_func(), m_quiet(quiet), m_last(time_point()), m_events(0u),
+      m_delivered(0u), m_pending(false) {
+    if constexpr (std::is_invocable_v<F&, std::size_t>) {
+      m_func.emplace(std::forward<F>(func));
+    }
+    else {
+      m_func.emplace([f = std::forward<F>(func)] (std::size_t) mutable { f(); });
+    }
+  }
+
+  debouncer(const debouncer&) = delete;
+  debouncer& operator=(const debouncer&) = delete;
+
+  /**
+   * Record an event. Only the first event of a burst performs a timer operation. Can be
+   * called from any thread.
+   */
+  void notify() {
+    m_last.store(Clock::now(), std::memory_order_release);
+    m_events.fetch_add(1u, std::memory_order_acq_rel);
+    if (m_pending.load(std::memory_order_acquire) ||
+        m_pending.exchange(true, std::memory_order_acq_rel)) {
+      return; // the running timer picks the event up
+    }
+    m_timer.start_duration_timer(m_quiet, [this] (std::error_code err, duration) {
+        return expired(err);
+      }
+    );
+  }
+
+  /**
+   * Drop a pending invocation. Events already recorded are delivered with the next
+   * burst.
+   */
+  void cancel() {
+    m_timer.cancel();
+  }
+
+  /**
+   * Return @c true if a burst is in progress, i.e. the function object will be invoked.
+   */
+  bool is_pending() const noexcept {
+    return m_pending.load(std::memory_order_acquire);
+  }
+};
+
+} // end namespace
+
+#endif
+
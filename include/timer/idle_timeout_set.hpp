@@ -0,0 +1,287 @@
+/** @file
+ *
+ * @brief Idle timeouts for many entries (e.g. connections) on a single @c periodic_timer,
+ * with entries kept in least recently used order in an intrusive list.
+ *
+ * One Asio timer per connection, restarted on each activity, puts every connection in
+ * the Asio timer queue and costs a cancel and a re-arm per activity. @c idle_timeout_set
+ * instead links each entry into a doubly linked list ordered by the time of its last
+ * activity. @c touch moves an entry to the tail of the list in constant time, without a
+ * timer operation or an allocation, and a single timepoint @c periodic_timer removes
+ * the expired entries from the head of the list on each tick. A sweep only visits the
+ * entries that have expired, plus one.
+ *
+ * Entries derive from @c idle_timeout_hook, which holds the list links and the time of
+ * the last activity:
+ *
+ * @code
+ *   struct connection : chops::idle_timeout_hook<> {
+ *     // ...
+ *   };
+ *
+ *   chops::idle_timeout_set<connection> idle { ioc, 30s, 1s, [] (connection& conn) {
+ *       // close the connection, which is no longer in the set
+ *     }
+ *   };
+ *   idle.start();
+ *   idle.insert(conn);
+ *   // on each activity
+ *   idle.touch(conn);
+ * @endcode
+ *
+ * An entry expires between one idle timeout and one idle timeout plus one tick after
+ * its last activity. The function object has the signature:
+ * @code
+ *   void (T&);
+ * @endcode
+ * The entry is removed from the set before the function object is invoked, so it can be
+ * destroyed or re-inserted from within the function object, which can also insert,
+ * touch or erase other entries.
+ *
+ * An @c idle_timeout_set is not internally synchronized: all methods must be called from
+ * the thread running the @c io_context (e.g. from the connection handlers), or before it
+ * is run. An entry must be erased from the set before it is destroyed. The application
+ * must keep the @c idle_timeout_set alive until its timer has finished.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef IDLE_TIMEOUT_SET_HPP_INCLUDED
+#define IDLE_TIMEOUT_SET_HPP_INCLUDED
+
+#include "asio/io_context.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <system_error>
+#include <type_traits> // std::is_base_of_v
+#include <utility> // std::forward
+
+#include "timer/inline_function.hpp"
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+template <typename T, typename Clock, std::size_t Capacity>
+class idle_timeout_set;
+
+/**
+ * Base class for the entries of an @c idle_timeout_set, holding the list links and the
+ * time of the last activity. Copying an entry does not copy its membership of a set.
+ */
+template <typename Clock = std::chrono::steady_clock>
+class idle_timeout_hook {
+private:
+  template <typename T, typename C, std::size_t Capacity>
+  friend class idle_timeout_set;
+
+  idle_timeout_hook* m_prev { nullptr };
+  idle_timeout_hook* m_next { nullptr };
+  typename Clock::time_point m_last { };
+
+public:
+  idle_timeout_hook() = default;
+  idle_timeout_hook(const idle_timeout_hook&) noexcept { }
+  idle_timeout_hook& operator=(const idle_timeout_hook&) noexcept { return *this; }
+  ~idle_timeout_hook() {
+    assert(!is_linked() && "entry destroyed while in an idle_timeout_set");
+  }
+
+  /**
+   * Return @c true if the entry is in an @c idle_timeout_set.
+   */
+  bool is_linked() const noexcept {
+    return m_next != nullptr;
+  }
+
+  /**
+   * Return the time of the last @c insert or @c touch.
+   */
+  typename Clock::time_point last_touch() const noexcept {
+    return m_last;
+  }
+};
+
+template <typename T, typename Clock = std::chrono::steady_clock, std::size_t Capacity = 64u>
+class idle_timeout_set {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+  using hook_type = idle_timeout_hook<Clock>;
+
+  static_assert(std::is_base_of_v<hook_type, T>,
+                "idle_timeout_set entries must derive from idle_timeout_hook");
+
+private:
+  periodic_timer<Clock> m_timer;
+  inline_function<void (T&), Capacity> m_func;
+  duration m_timeout;
+  duration m_tick;
+  // sentinel of the circular list, the head (least recently touched) is m_list.m_next
+  hook_type m_list;
+  std::size_t m_size;
+
+private:
+  void link_tail(hook_type& h) noexcept {
+    h.m_prev = m_list.m_prev;
+    h.m_next = &m_list;
+    m_list.m_prev->m_next = &h;
+    m_list.m_prev = &h;
+  }
+  static void unlink(hook_type& h) noexcept {
+    h.m_prev->m_next = h.m_next;
+    h.m_next->m_prev = h.m_prev;
+    h.m_prev = nullptr;
+    h.m_next = nullptr;
+  }
+
+  void sweep() {
+    time_point expired_before { Clock::now() - m_timeout };
+    while (m_list.m_next != &m_list && m_list.m_next->m_last <= expired_before) {
+      hook_type& h { *m_list.m_next };
+      unlink(h);
+      --m_size;
+      m_func(static_cast<T&>(h));
+    }
+  }
+
+public:
+
+  /**
+   * Construct an @c idle_timeout_set.
+   *
+   * @param ioc @c io_context for the sweep timer.
+   *
+   * @param timeout Time without activity after which an entry expires.
+   *
+   * @param tick Interval between sweeps, which is the precision of the expiry.
+   *
+   * @param func Function object invoked for each expired entry.
+   */
+  template <typename F>
+  idle_timeout_set(asio::io_context& ioc, const duration& timeout, const duration& tick,
+                   F&& func) :
+      m_timer(ioc), m_func(std::forward<F>(func)), m_timeout(timeout), m_tick(tick),
+      m_list(), m_size(0u) {
+    m_list.m_prev = &m_list;
+    m_list.m_next = &m_list;
+  }
+
+  idle_timeout_set(const idle_timeout_set&) = delete;
+  idle_timeout_set& operator=(const idle_timeout_set&) = delete;
+
+  ~idle_timeout_set() {
+    clear();
+    m_list.m_prev = nullptr;
+    m_list.m_next = nullptr;
+  }
+
+  /**
+   * Start sweeping for expired entries.
+   */
+  void start() {
+    m_timer.start_timepoint_timer(m_tick,
+      [this] (std::error_code err, duration, std::size_t) {
+        if (err) {
+          return false;
+        }
+        sweep();
+        return true;
+      }
+    );
+  }
+
+  /**
+   * Stop sweeping. The entries stay in the set.
+   */
+  void stop() {
+    m_timer.cancel();
+  }
+
+  /**
+   * Insert an entry, as most recently active. An entry already in the set is touched.
+   *
+   * @param entry Entry, which must not be in another set.
+   */
+  void insert(T& entry) {
+    insert(entry, Clock::now());
+  }
+  /**
+   * Insert an entry with a time of last activity already read by the caller, which must 
+   * not be earlier than the time of any entry already in the set.
+   */
+  void insert(T& entry, const time_point& now_time) {
+    hook_type& h { entry };
+    if (h.is_linked()) {
+      unlink(h);
+      --m_size;
+    }
+    h.m_last = now_time;
+    link_tail(h);
+    ++m_size;
+  }
+
+  /**
+   * Record activity on an entry, moving it to the tail of the list. Constant time, with
+   * no timer operation. An entry not in the set is inserted.
+   */
+  void touch(T& entry) {
+    insert(entry, Clock::now());
+  }
+  /**
+   * Record activity with a time already read by the caller, e.g. to share one clock
+   * read between the entries touched by a batch of completions.
+   */
+  void touch(T& entry, const time_point& now_time) {
+    insert(entry, now_time);
+  }
+
+  /**
+   * Remove an entry from the set, without invoking the function object. Removing an
+   * entry that is not in the set has no effect.
+   */
+  void erase(T& entry) noexcept {
+    hook_type& h { entry };
+    if (h.is_linked()) {
+      unlink(h);
+      --m_size;
+    }
+  }
+
+  /**
+   * Remove all entries, without invoking the function object.
+   */
+  void clear() noexcept {
+    while (m_list.m_next != &m_list) {
+      unlink(*m_list.m_next);
+    }
+    m_size = 0u;
+  }
+
+  /**
+   * Return the number of entries in the set.
+   */
+  std::size_t size() const noexcept {
+    return m_size;
+  }
+
+  /**
+   * Return @c true if the set has no entries.
+   */
+  bool empty() const noexcept {
+    return m_size == 0u;
+  }
+};
+
+} // end namespace
+
+#endif
+
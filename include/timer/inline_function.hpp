@@ -0,0 +1,154 @@
+/** @file
+ *
+ * @brief Type-erased function object wrapper with fixed-size inline storage.
+ *
+ * @c inline_function is similar to @c std::function, except that the wrapped function
+ * object is always stored inside the @c inline_function object, never on the heap. A
+ * function object larger than the capacity (e.g. a lambda with large captures) is a
+ * compile time error rather than a heap allocation.
+ *
+ * An @c inline_function is move-only, and the wrapped function object only needs to
+ * be move constructible. Invoking it is a single indirect call.
+ *
+ * It is used by @c periodic_timer to store the application function object when the
+ * @c CallbackCapacity template parameter is not zero.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef INLINE_FUNCTION_HPP_INCLUDED
+#define INLINE_FUNCTION_HPP_INCLUDED
+
+#include <cstddef> // std::size_t, std::max_align_t
+#include <new> // placement new, std::launder
+#include <type_traits> // std::decay_t, std::is_same_v, std::remove_cvref_t
+#include <utility> // std::move, std::forward
+
+namespace chops {
+
+template <typename Sig, std::size_t Capacity>
+class inline_function;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class inline_function<R(Args...), Capacity> {
+private:
+
+  using invoke_func = R (*)(void*, Args...);
+  // move constructs into the destination, then destroys the source; a null
+  // destination only destroys
+  using relocate_func = void (*)(void*, void*) noexcept;
+
+  alignas(std::max_align_t) unsigned char m_buf[Capacity];
+  invoke_func m_invoke;
+  relocate_func m_relocate;
+
+  template <typename T>
+  static T* ptr(void* p) noexcept {
+    return std::launder(static_cast<T*>(p));
+  }
+
+public:
+
+  /**
+   * Construct an empty @c inline_function.
+   */
+  inline_function() noexcept : m_invoke(nullptr), m_relocate(nullptr) { }
+
+  /**
+   * Construct an @c inline_function wrapping the function object.
+   */
+  template <typename F>
+    requires (!std::is_same_v<std::remove_cvref_t<F>, inline_function>)
+  inline_function(F&& func) : m_invoke(nullptr), m_relocate(nullptr) {
+    emplace(std::forward<F>(func));
+  }
+
+  inline_function(const inline_function&) = delete;
+  inline_function& operator=(const inline_function&) = delete;
+
+  inline_function(inline_function&& rhs) noexcept :
+      m_invoke(rhs.m_invoke), m_relocate(rhs.m_relocate) {
+    if (m_relocate) {
+      m_relocate(m_buf, rhs.m_buf);
+      rhs.m_invoke = nullptr;
+      rhs.m_relocate = nullptr;
+    }
+  }
+  inline_function& operator=(inline_function&& rhs) noexcept {
+    if (this != &rhs) {
+      reset();
+      if (rhs.m_relocate) {
+        rhs.m_relocate(m_buf, rhs.m_buf);
+        m_invoke = rhs.m_invoke;
+        m_relocate = rhs.m_relocate;
+        rhs.m_invoke = nullptr;
+        rhs.m_relocate = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~inline_function() {
+    reset();
+  }
+
+  /**
+   * Replace the wrapped function object. Fails to compile if the function object does
+   * not fit in the inline storage.
+   */
+  template <typename F>
+    requires (!std::is_same_v<std::remove_cvref_t<F>, inline_function>)
+  void emplace(F&& func) {
+    using T = std::decay_t<F>;
+    static_assert(sizeof(T) <= Capacity,
+        "function object (e.g. lambda captures) does not fit in the inline capacity");
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+        "function object alignment is not supported by the inline storage");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+        "function object must be nothrow move constructible");
+    reset();
+    ::new (static_cast<void*>(m_buf)) T(std::forward<F>(func));
+    m_invoke = [] (void* p, Args... args) -> R {
+      return (*ptr<T>(p))(std::forward<Args>(args)...);
+    };
+    m_relocate = [] (void* dest, void* src) noexcept {
+      if (dest) {
+        ::new (dest) T(std::move(*ptr<T>(src)));
+      }
+      ptr<T>(src)->~T();
+    };
+  }
+
+  /**
+   * Destroy the wrapped function object, if any.
+   */
+  void reset() noexcept {
+    if (m_relocate) {
+      m_relocate(nullptr, m_buf);
+      m_invoke = nullptr;
+      m_relocate = nullptr;
+    }
+  }
+
+  /**
+   * Invoke the wrapped function object, which must not be empty.
+   */
+  R operator()(Args... args) {
+    return m_invoke(m_buf, std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const noexcept {
+    return m_invoke != nullptr;
+  }
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,161 @@
+/** @file
+ *
+ * @brief A synchronous periodic loop, invoking a function object on a timepoint grid
+ * from the calling thread.
+ *
+ * @c periodic_loop is the blocking counterpart of a @c periodic_timer timepoint timer,
+ * for control loops that run on a dedicated thread and don't need an @c io_context.
+ * There is no reactor, no handler allocation and no executor involved; the calling
+ * thread sleeps until each timepoint and then invokes the function object.
+ *
+ * The timepoint calculations are the same as for @c periodic_timer::start_timepoint_timer,
+ * so the loop does not drift, and timepoints that have already passed (e.g. after a slow
+ * callback) are invoked in quick succession.
+ *
+ * On Linux the sleep is an absolute @c clock_nanosleep (@c TIMER_ABSTIME) on the POSIX
+ * clock corresponding to the clock type (@c CLOCK_MONOTONIC for @c steady_clock,
+ * @c CLOCK_REALTIME for @c system_clock, and the clocks in "timer/clocks.hpp"), which
+ * avoids the rounding and the extra clock read of a relative sleep. Other clocks and
+ * platforms use @c std::this_thread::sleep_until.
+ *
+ * @code
+ *   chops::periodic_loop<> loop;
+ *   std::thread thr([&loop] {
+ *     loop.run(1ms, [] (std::error_code err, std::chrono::steady_clock::duration elap) {
+ *       // control processing
+ *       return !err;
+ *     });
+ *   });
+ *   // ...
+ *   loop.cancel();
+ *   thr.join();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef PERIODIC_LOOP_HPP_INCLUDED
+#define PERIODIC_LOOP_HPP_INCLUDED
+
+#include "asio/error.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread> // std::this_thread
+#include <utility> // std::forward
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h> // clock_nanosleep
+#endif
+
+#include "timer/posix_clock.hpp"
+
+namespace chops {
+
+namespace detail {
+
+template <typename Clock>
+void sleep_until(const typename Clock::time_point& tp) {
+#ifdef __linux__
+  if constexpr (posix_clock<Clock>::available) {
+    timespec ts { to_timespec(tp.time_since_epoch()) };
+    while (::clock_nanosleep(posix_clock<Clock>::id, TIMER_ABSTIME, &ts, nullptr) == EINTR) { }
+    return;
+  }
+#endif
+  std::this_thread::sleep_until(tp);
+}
+
+} // end detail namespace
+
+template <typename Clock = std::chrono::steady_clock>
+class periodic_loop {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+private:
+  std::atomic<bool> m_cancel;
+
+public:
+
+  /**
+   * Construct a @c periodic_loop.
+   */
+  periodic_loop() noexcept : m_cancel(false) { }
+
+  periodic_loop(const periodic_loop&) = delete;
+  periodic_loop& operator=(const periodic_loop&) = delete;
+
+  /**
+   * Run the loop in the calling thread, first invoking the function object after one
+   * duration, then on each following timepoint. Returns when the function object returns
+   * @c false, or after the loop has been cancelled.
+   *
+   * @param dur Interval between timepoints.
+   *
+   * @param func Function object with the same signature as for @c periodic_timer:
+   * @code
+   *   bool (std::error_code, duration);
+   * @endcode
+   */
+  template <typename F>
+  void run(const duration& dur, F&& func) {
+    run(dur, (Clock::now() + dur), std::forward<F>(func));
+  }
+
+  /**
+   * Run the loop in the calling thread, first invoking the function object at a specified
+   * time point, then on each following timepoint.
+   *
+   * @param dur Interval between timepoints.
+   *
+   * @param when Time point of the first invocation.
+   *
+   * @param func Function object, as above.
+   */
+  template <typename F>
+  void run(const duration& dur, const time_point& when, F&& func) {
+    time_point last_tp { when - dur };
+    time_point tp { when };
+    for (;;) {
+      detail::sleep_until<Clock>(tp);
+      time_point now_time { Clock::now() };
+      if (m_cancel.exchange(false, std::memory_order_acquire)) {
+        func(std::error_code(asio::error::operation_aborted), (now_time - last_tp));
+        return;
+      }
+      // pass elapsed time to app function obj, same as for a timepoint timer
+      if (!func(std::error_code(), (now_time - last_tp))) {
+        return;
+      }
+      last_tp = tp;
+      tp += dur;
+    }
+  }
+
+  /**
+   * Cancel the loop from another thread. The loop wakes up on its next timepoint, invokes
+   * the function object with @c asio::error::operation_aborted (the same error code as
+   * for a cancelled @c periodic_timer), and returns.
+   *
+   * A cancel before @c run is called ends the next @c run on its first timepoint.
+   */
+  void cancel() noexcept {
+    m_cancel.store(true, std::memory_order_release);
+  }
+};
+
+} // end namespace
+
+#endif
+
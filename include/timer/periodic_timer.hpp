@@ -35,6 +35,8 @@
  * system clock adjustments. In addition, if the timepoint interval is small and a large 
  * amount of processing is performed by the callback, "overflow" can occur, where the next 
  * timepoint callback is overrun by the current processing.
+ * A callback accepting an expiration count (see the constructor documentation) is 
+ * instead invoked once with the number of timepoints that have passed.
  *
  * An excellent article on this topic by Tony DaSilva can be [read here]
  * (https://bulldozer00.blog/2013/12/27/periodic-processing-with-standard-c11-facilities/).
@@ -50,16 +52,66 @@
  * on a time stamp) will need to create their own containers and data structures, using 
  * @c periodic_timer as a container element.
  *
+ * Per-timer application state can be held inside the timer by specifying the @c State 
+ * template parameter, with the callback receiving a @c State reference.
+ *
+ * By default the function object is moved from handler to handler. With a non-zero 
+ * @c CallbackCapacity template parameter it is instead stored once inside the timer 
+ * (see @c timer/inline_function.hpp), with no heap allocation. All timers with the 
+ * same capacity have the same type regardless of the function object, so they can be 
+ * held in a single container.
+ *
  * Asynchronous processing is performed by the Asio @c io_context (C++ executor context) passed 
  * in to the constructor by the application.
+ * @c periodic_timer_runner (see @c timer/periodic_timer_runner.hpp) packages an 
+ * @c io_context with a dedicated (optionally pinned and real-time) thread.
+ * For a dedicated thread that doesn't need an @c io_context at all, @c periodic_loop 
+ * (see @c timer/periodic_loop.hpp) runs the same timepoint sequence synchronously.
+ * On Linux, @c timerfd_timer (see @c timer/timerfd_timer.hpp) arms a kernel periodic 
+ * @c timerfd once per start instead of re-arming an Asio timer on each tick.
+ * For watchdogs whose deadline is pushed out by frequent activity, @c deadline_timer 
+ * (see @c timer/deadline_timer.hpp) takes a kick as an atomic store and re-arms lazily.
+ * Bursts of events can be coalesced with @c debouncer and @c throttler (see 
+ * @c timer/debouncer.hpp and @c timer/throttler.hpp), each built on one @c periodic_timer.
+ * @c token_bucket (see @c timer/token_bucket.hpp) is a rate limiter refilled by a 
+ * @c periodic_timer, with a lock-free acquire.
+ * Idle timeouts for many connections can share one @c periodic_timer through 
+ * @c idle_timeout_set (see @c timer/idle_timeout_set.hpp).
+ * Timeouts for many outstanding asynchronous operations can share one timer through 
+ * the timing wheel of @c timeout_manager (see @c timer/timeout_manager.hpp).
  * 
  * A @c periodic_timer stops when the application supplied function object 
- * returns @c false rather than @c true.
+ * returns @c false rather than @c true, or when a stop condition passed in 
+ * @c start_options (a maximum tick count or an end time point) is met.
  *
  * A periodic timer can be used as a "one-shot" timer by finishing after 
  * one invocation (i.e. unconditionally return @c false from the function 
  * object).
  *
+ * The period of a running timer can be changed with @c set_period, without 
+ * cancelling and restarting the timer. The new period is used on the next re-arm.
+ *
+ * Clock jumps (e.g. an NTP step of @c system_clock) can be detected with 
+ * @c set_clock_jump_threshold or reported with @c clock_jumped, in which case the 
+ * timer re-anchors and notifies the callback with @c chops::timer_errc::clock_jump 
+ * (see @c timer/timer_error.hpp), rather than bursting through missed timepoints or 
+ * stalling.
+ *
+ * A third option, @c start_rate_timer, holds the average rate of a timepoint timer 
+ * while compensating wake-up latency, and spreads out the catch-up after falling 
+ * behind with a minimum gap between callbacks.
+ *
+ * A timepoint timer can be started on a wall clock boundary (e.g. each second on the 
+ * second on every host) by passing @c aligned_time_point (see @c timer/aligned_start.hpp) 
+ * as the first time point.
+ *
+ * A timer can be suspended with @c pause and continued with @c resume. The function 
+ * object and the timepoint sequence are kept across the pause.
+ *
+ * Slow callbacks can be run on a separate executor (e.g. an @c asio::thread_pool) by 
+ * wrapping the function object with @c offload (see @c timer/callback_offload.hpp), 
+ * so that they do not delay other timers serviced by the same @c io_context.
+ *
  * @note This class does not perform "this" reference counting. It is up to 
  * the application code to guarantee that a @c periodic_timer has not been 
  * destructed before handlers (function object callbacks) are invoked.
@@ -67,6 +119,9 @@
  * A common idiom is to use @c std::enable_shared_from_this, call 
  * @c std::shared_from_this, and store the result in the function object 
  * callback object.
+ *
+ * Alternatively, @c spawn_periodic (see @c timer/spawn_periodic.hpp) creates a 
+ * self-owning timer from a pool, which is released when the timer finishes.
  *  
  * @note @c std::chrono facilities seem to be underspecified on @c noexcept,
  * very few of the functions in @c periodic_timer are @c noexcept.
@@ -83,57 +138,774 @@
 #ifndef PERIODIC_TIMER_HPP_INCLUDED
 #define PERIODIC_TIMER_HPP_INCLUDED
 
+#include "asio/any_io_executor.hpp"
 #include "asio/basic_waitable_timer.hpp"
+#include "asio/execution_context.hpp"
 #include "asio/io_context.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "timer/inline_function.hpp"
+#include "timer/timer_error.hpp"
 
+#include <algorithm> // std::clamp
+#include <atomic>
+#include <cassert>
 #include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <optional>
 #include <system_error>
-#include <utility> // std::move, std::forward
+#include <thread> // std::this_thread
+#include <type_traits> // std::is_invocable_v, std::conditional_t
+#include <utility> // std::move, std::forward, std::in_place_t
 
 namespace chops {
 
-template <typename Clock = std::chrono::steady_clock>
+/**
+ * Specifies how a period change through @c periodic_timer::set_period is applied to 
+ * a timepoint timer. Duration timers are always relative to the last callback, so 
+ * the policy does not affect them.
+ *
+ * @c preserve_phase continues the timepoint sequence from the last scheduled timepoint, 
+ * using the new period for the following intervals.
+ *
+ * @c re_anchor starts a new timepoint sequence from the time of the next re-arm.
+ */
+enum class period_change { preserve_phase, re_anchor };
+
+namespace detail {
+
+// placeholder for a periodic_timer without an application State object
+struct no_state { };
+
+// placeholder for a periodic_timer that doesn't store the application function object
+struct no_callback { };
+
+// added to an execution context that is run without Asio internal locking (see 
+// periodic_timer_runner), so that timers on it can check the calling thread in debug 
+// builds
+class single_threaded_marker : public asio::execution_context::service {
+public:
+  static inline asio::execution_context::id id;
+
+  explicit single_threaded_marker(asio::execution_context& ctx) : 
+      asio::execution_context::service(ctx) { }
+
+private:
+  void shutdown() override { }
+};
+
+}
+
+/**
+ * Stop conditions evaluated by @c periodic_timer itself, passed to any of the @c start 
+ * methods, e.g. for an N-shot timer:
+ * @code
+ *   timer.start_duration_timer(100ms, func, { .max_ticks = 3u });
+ * @endcode
+ *
+ * When a condition is met the timer finishes after the callback, without arming a 
+ * final wait, the same as if the function object had returned @c false.
+ */
+template <typename Clock>
+struct start_options {
+  // number of timepoints after which the timer finishes, zero for no limit; a batch 
+  // callback invocation counts each of its expirations
+  std::size_t max_ticks { 0u };
+  // the timer finishes instead of arming a wait that expires after this time point
+  typename Clock::time_point until { Clock::time_point::max() };
+};
+
+template <typename Clock = std::chrono::steady_clock, typename State = void, 
+          std::size_t CallbackCapacity = 0u, typename WaitTraits = asio::wait_traits<Clock>,
+          typename Executor = asio::any_io_executor>
 class periodic_timer {
 public:
 
   using duration = typename Clock::duration;
   using time_point = typename Clock::time_point;
+  using wait_traits_type = WaitTraits;
+  using executor_type = Executor;
+  using state_type = std::conditional_t<std::is_void_v<State>, detail::no_state, State>;
+  using options_type = start_options<Clock>;
 
 private:
 
-  asio::basic_waitable_timer<Clock> m_timer;
+  // The control word holds the phase of the timer, requests made through cancel, pause, 
+  // resume and clock_jumped, and a generation count incremented by each start, so that handlers 
+  // belonging to a previous start are recognized.
+  //
+  // Only one party at a time accesses the Asio timer object: the handler while the 
+  // phase is running, or a start, cancel, pause or resume call while the phase is busy. 
+  // Neither runs application code, so these windows are short. The handler releases the 
+  // Asio timer while the function object runs (the callback phase): a start then takes 
+  // the timer over without waiting for the callback, and other requests are flagged, for 
+  // the handler to act on before re-arming.
+  using control_type = std::uint32_t;
+
+  static constexpr control_type idle = 0u; // no pending wait
+  static constexpr control_type armed = 1u; // wait pending, handler not running
+  static constexpr control_type running = 2u; // handler running, owns the Asio timer
+  static constexpr control_type busy = 3u; // a start, cancel, pause or resume owns the Asio timer
+  static constexpr control_type in_callback = 4u; // handler running the function object
+  static constexpr control_type phase_mask = 7u;
+  static constexpr control_type cancel_flag = 8u;
+  static constexpr control_type pause_flag = 16u;
+  static constexpr control_type resume_flag = 32u;
+  static constexpr control_type jump_flag = 64u;
+  static constexpr control_type flag_mask = cancel_flag | pause_flag | resume_flag | jump_flag;
+  static constexpr control_type gen_one = 128u;
+  static constexpr control_type gen_mask = ~(gen_one - 1u);
+
+  asio::basic_waitable_timer<Clock, WaitTraits, Executor> m_timer;
+  [[no_unique_address]] state_type m_state;
+
+  // with a non-zero capacity the function object is stored in the timer, and each 
+  // handler carries a reference to it instead of the function object itself
+  static constexpr bool stores_callback = CallbackCapacity > 0u;
+
+  using stored_callback = std::conditional_t<stores_callback, 
+          inline_function<bool (periodic_timer&, const std::error_code&, duration, std::size_t),
+                          CallbackCapacity>,
+          detail::no_callback>;
+
+  [[no_unique_address]] stored_callback m_callback;
+  std::atomic<duration> m_period;
+  std::atomic<bool> m_re_anchor;
+  std::atomic<bool> m_skip_missed;
+  std::atomic<control_type> m_control;
+  std::atomic<std::thread::id> m_handler_thread;
+  std::atomic_flag m_callback_active { };
+  std::atomic<time_point> m_expiry { time_point::max() };
+  std::atomic<duration> m_jump_threshold { duration::zero() };
+  // clock readings when the Asio timer was last armed, only accessed by the party 
+  // owning the Asio timer
+  time_point m_arm_time { };
+  std::chrono::steady_clock::time_point m_arm_steady { };
+  // rate timer controller state, only accessed by the party owning the Asio timer
+  duration m_min_gap { };
+  duration m_rate_integral { };
+  duration m_rate_correction { };
+  bool m_rate_clamped { false };
+  time_point m_last_callback { };
+  // delay returned by a function object returning std::optional<duration>, only 
+  // accessed by the party owning the Asio timer
+  duration m_next_delay { };
+  // stop conditions from the start options, and the ticks counted against them, only 
+  // accessed by the party owning the Asio timer
+  std::size_t m_max_ticks { 0u };
+  std::size_t m_ticks { 0u };
+  time_point m_until { time_point::max() };
 
 private:
+  // with ASIO_CONCURRENCY_HINT_UNSAFE Asio does no internal locking, and a timer 
+  // with a live handler must only be used from the thread that runs its handlers; the 
+  // context is marked by periodic_timer_runner, and is looked up on each check so that 
+  // the layout of the timer doesn't depend on NDEBUG
+  void check_thread() {
+#ifndef NDEBUG
+    if (asio::has_service<detail::single_threaded_marker>(
+            asio::query(m_timer.get_executor(), asio::execution::context))) {
+      std::thread::id id { m_handler_thread.load(std::memory_order_relaxed) };
+      assert((id == std::thread::id() || id == std::this_thread::get_id()) &&
+             "single-threaded periodic_timer used from another thread");
+    }
+#endif
+  }
+  // a function object with a State reference parameter is only recognized when 
+  // State is not void
+  template <typename F, typename... Args>
+  static constexpr bool takes_state = 
+      !std::is_void_v<State> && std::is_invocable_v<F&, state_type&, Args...>;
+
+  template <typename F>
+  static constexpr bool is_batch_callback = 
+      std::is_invocable_v<F&, const std::error_code&, duration, std::size_t> ||
+      takes_state<F, const std::error_code&, duration, std::size_t>;
+
+  template <typename F>
+  static auto invoke_with(F& func, state_type& st, const std::error_code& err, 
+                          const duration& elap, std::size_t expirations) {
+    if constexpr (takes_state<F, const std::error_code&, duration, std::size_t>) {
+      return func(st, err, elap, expirations);
+    }
+    else if constexpr (takes_state<F, const std::error_code&, duration>) {
+      return func(st, err, elap);
+    }
+    else if constexpr (is_batch_callback<F>) {
+      return func(err, elap, expirations);
+    }
+    else {
+      return func(err, elap);
+    }
+  }
+  // a function object returning std::optional<duration> supplies the delay to the 
+  // next invocation, the bool returning path is unchanged; a stored function object 
+  // reference tells whether the function object behind it returns a delay
+  template <typename F>
+  static constexpr bool returns_delay_impl() {
+    if constexpr (requires { F::returns_delay; }) {
+      return F::returns_delay;
+    }
+    else {
+      return std::is_same_v<decltype(invoke_with(std::declval<F&>(), std::declval<state_type&>(),
+                                                 std::error_code(), duration(), std::size_t())),
+                            std::optional<duration>>;
+    }
+  }
+  template <typename F>
+  static constexpr bool returns_delay = returns_delay_impl<std::decay_t<F>>();
+
+  template <typename F>
+  bool invoke(F& func, const std::error_code& err, const duration& elap, 
+              std::size_t expirations) {
+    if constexpr (returns_delay<F> && !requires { F::returns_delay; }) {
+      std::optional<duration> next { invoke_with(func, m_state, err, elap, expirations) };
+      if (!next) {
+        return false;
+      }
+      m_next_delay = *next;
+      return true;
+    }
+    else {
+      return invoke_with(func, m_state, err, elap, expirations);
+    }
+  }
+  // the "operation aborted" notification for a handler of a previous start, which 
+  // doesn't own the Asio timer or the handler state: it is serialized with the 
+  // callbacks of the new start, and a returned delay is discarded
+  template <typename F>
+  void notify_replaced(F& func, const duration& elap) {
+    while (m_callback_active.test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    invoke_with(func, m_state, asio::error::operation_aborted, elap, 0u);
+    m_callback_active.clear(std::memory_order_release);
+  }
+  // interval to the next expiry, from the function object or the period
+  template <typename F>
+  duration next_interval() const {
+    if constexpr (returns_delay<F>) {
+      return m_next_delay;
+    }
+    else {
+      return m_period.load(std::memory_order_relaxed);
+    }
+  }
+
+  // passed from handler to handler in place of a stored function object, with the 
+  // same signature as the stored function object so that expiration counts are 
+  // computed only when needed
+  template <bool Batch, bool Delay>
+  struct stored_callback_ref {
+    static constexpr bool returns_delay = Delay;
+
+    periodic_timer* m_self;
+
+    bool operator()(const std::error_code& err, const duration& elap) requires (!Batch) {
+      return m_self->m_callback(*m_self, err, elap, 1u);
+    }
+    bool operator()(const std::error_code& err, const duration& elap, 
+                    std::size_t expirations) requires Batch {
+      return m_self->m_callback(*m_self, err, elap, expirations);
+    }
+  };
+
+  template <typename F>
+  decltype(auto) prepare_callback(F&& func) {
+    if constexpr (stores_callback) {
+      using func_type = std::decay_t<F>;
+      m_callback.emplace([f = func_type(std::forward<F>(func))] (periodic_timer& self, 
+              const std::error_code& err, duration elap, std::size_t expirations) mutable {
+          return self.invoke(f, err, elap, expirations);
+        }
+      );
+      return stored_callback_ref<is_batch_callback<func_type>, returns_delay<func_type>> { this };
+    }
+    else {
+      return std::forward<F>(func);
+    }
+  }
+
   template <typename F>
-  void duration_handler_impl(const time_point& last_tp, const duration& dur, 
+  void duration_handler_impl(control_type gen, const time_point& last_tp, const time_point& expiry,
                              const std::error_code& err, F&& func) {
+    control_type flags { };
+    if (!enter_handler(gen, flags)) {
+      if constexpr (!stores_callback) { // otherwise already replaced by the new start
+        notify_replaced(func, Clock::now() - last_tp);
+      }
+      return; // handler from a previous start
+    }
     time_point now_time { Clock::now() };
+    bool more { };
+    if (flags & cancel_flag) {
+      if (run_callback(gen, func, asio::error::operation_aborted, now_time - last_tp, 0u, more)) {
+        finish_handler(gen);
+      }
+      return; // timer was cancelled
+    }
+    if (flags & pause_flag) {
+      duration_wait(gen, last_tp, paused_timepoint(flags, expiry), std::forward<F>(func));
+      return;
+    }
+    if (clock_jump(flags, now_time)) {
+      if (!run_callback(gen, func, make_error_code(timer_errc::clock_jump), now_time - last_tp, 
+                        0u, more)) {
+        return;
+      }
+      if (!more) {
+        finish_handler(gen);
+        return;
+      }
+      duration_wait(gen, now_time, Clock::now() + m_period.load(std::memory_order_relaxed),
+                    std::forward<F>(func));
+      return;
+    }
+    m_ticks += 1u;
     // pass err and elapsed time to app function obj
-    if (!func(err, now_time - last_tp) || 
-        err == asio::error::operation_aborted) {
+    if (!run_callback(gen, func, err, now_time - last_tp, 1u, more)) {
+      return; // cancelled, or a start owns the timer now
+    }
+    if (!more || err == asio::error::operation_aborted) {
+      finish_handler(gen);
       return; // app is finished with timer for now or timer was cancelled
     }
-    m_timer.expires_after(dur);
-    m_timer.async_wait( [now_time, dur, f = std::move(func), this]
-            (const std::error_code& e) {
-        duration_handler_impl(now_time, dur, e, std::move(f));
+    duration_wait(gen, now_time, Clock::now() + next_interval<F>(), std::forward<F>(func));
+  }
+  template <typename F>
+  void duration_wait(control_type gen, const time_point& last_tp, const time_point& expiry, F&& func) {
+    if (limit_reached(expiry)) {
+      finish_handler(gen);
+      return;
+    }
+    bool parked { arm(expiry) };
+    m_timer.async_wait( [gen, last_tp, expiry, f = std::move(func), this]
+            (const std::error_code& e) mutable {
+        duration_handler_impl(gen, last_tp, expiry, e, std::move(f));
       }
     );
+    leave_handler(parked);
   }
   template <typename F>
-  void timepoint_handler_impl(const time_point& last_tp, const duration& dur, 
+  void timepoint_handler_impl(control_type gen, const time_point& last_tp, const time_point& tp,
                               const std::error_code& err, F&& func) {
+    control_type flags { };
+    if (!enter_handler(gen, flags)) {
+      if constexpr (!stores_callback) { // otherwise already replaced by the new start
+        notify_replaced(func, Clock::now() - last_tp);
+      }
+      return; // handler from a previous start
+    }
+    bool more { };
+    if (flags & cancel_flag) {
+      if (run_callback(gen, func, asio::error::operation_aborted, (Clock::now() - last_tp), 
+                       0u, more)) {
+        finish_handler(gen);
+      }
+      return; // timer was cancelled
+    }
+    if (flags & pause_flag) {
+      timepoint_wait(gen, last_tp, paused_timepoint(flags, tp), std::forward<F>(func));
+      return;
+    }
+    time_point now_time { Clock::now() };
+    if (clock_jump(flags, now_time)) {
+      // re-anchor the timepoint sequence to the new time, rather than catching up on 
+      // the timepoints skipped by a forward jump, or waiting out a backward jump
+      if (!run_callback(gen, func, make_error_code(timer_errc::clock_jump), now_time - last_tp, 
+                        0u, more)) {
+        return;
+      }
+      if (!more) {
+        finish_handler(gen);
+        return;
+      }
+      timepoint_wait(gen, now_time, now_time + m_period.load(std::memory_order_relaxed),
+                     std::forward<F>(func));
+      return;
+    }
+    // a batch callback is invoked once for all timepoints that have passed, instead of 
+    // once for each of them
+    std::size_t expirations { 1u };
+    time_point last_expired { tp };
+    if constexpr (is_batch_callback<F>) {
+      duration dur { m_period.load(std::memory_order_relaxed) };
+      if (now_time > tp && dur > duration::zero()) {
+        expirations += static_cast<std::size_t>((now_time - tp) / dur);
+        last_expired += (expirations - 1u) * dur;
+      }
+    }
+    m_ticks += expirations;
     // pass err and elapsed time to app function obj
-    if (!func(err, (Clock::now() - last_tp)) || 
-        err == asio::error::operation_aborted) {
+    if (!run_callback(gen, func, err, (now_time - last_tp), expirations, more)) {
+      return; // cancelled, or a start owns the timer now
+    }
+    if (!more || err == asio::error::operation_aborted) {
+      finish_handler(gen);
+      return; // app is finished with timer for now or timer was cancelled
+    }
+    // any period change from set_period is picked up here
+    timepoint_wait(gen, last_expired, next_timepoint<F>(last_expired), std::forward<F>(func));
+  }
+  template <typename F>
+  void timepoint_wait(control_type gen, const time_point& last_tp, const time_point& tp, F&& func) {
+    if (limit_reached(tp)) {
+      finish_handler(gen);
+      return;
+    }
+    bool parked { arm(tp) };
+    m_timer.async_wait( [gen, f = std::move(func), last_tp, tp, this]
+            (const std::error_code& e) mutable {
+        timepoint_handler_impl(gen, last_tp, tp, e, std::move(f));
+      }
+    );
+    leave_handler(parked);
+  }
+  template <typename F>
+  void rate_handler_impl(control_type gen, const time_point& last_tp, const time_point& tp,
+                         const std::error_code& err, F&& func) {
+    control_type flags { };
+    if (!enter_handler(gen, flags)) {
+      if constexpr (!stores_callback) { // otherwise already replaced by the new start
+        notify_replaced(func, Clock::now() - last_tp);
+      }
+      return; // handler from a previous start
+    }
+    bool more { };
+    if (flags & cancel_flag) {
+      if (run_callback(gen, func, asio::error::operation_aborted, (Clock::now() - last_tp), 
+                       0u, more)) {
+        finish_handler(gen);
+      }
+      return; // timer was cancelled
+    }
+    if (flags & pause_flag) {
+      rate_wait(gen, last_tp, paused_timepoint(flags, tp), std::forward<F>(func));
+      return;
+    }
+    time_point now_time { Clock::now() };
+    if (clock_jump(flags, now_time)) {
+      if (!run_callback(gen, func, make_error_code(timer_errc::clock_jump), now_time - last_tp, 
+                        0u, more)) {
+        return;
+      }
+      if (!more) {
+        finish_handler(gen);
+        return;
+      }
+      reset_rate_control(now_time);
+      rate_wait(gen, now_time, now_time + m_period.load(std::memory_order_relaxed),
+                std::forward<F>(func));
+      return;
+    }
+    m_last_callback = now_time;
+    m_ticks += 1u;
+    // pass err and elapsed time to app function obj, same as for a timepoint timer
+    if (!run_callback(gen, func, err, (now_time - last_tp), 1u, more)) {
+      return; // cancelled, or a start owns the timer now
+    }
+    if (!more || err == asio::error::operation_aborted) {
+      finish_handler(gen);
       return; // app is finished with timer for now or timer was cancelled
     }
-    m_timer.expires_at(last_tp + dur + dur);
-    m_timer.async_wait( [f = std::move(func), last_tp, dur, this]
-            (const std::error_code& e) {
-        timepoint_handler_impl(last_tp+dur, dur, e, std::move(f));
+    update_rate_correction(now_time - tp, next_interval<F>());
+    rate_wait(gen, tp, next_timepoint<F>(tp), std::forward<F>(func));
+  }
+  // arm ahead of the ideal timepoint by the controller correction, but no sooner than 
+  // the minimum gap after the last callback
+  template <typename F>
+  void rate_wait(control_type gen, const time_point& last_tp, const time_point& tp, F&& func) {
+    time_point expiry { tp - m_rate_correction };
+    time_point earliest { m_last_callback + m_min_gap };
+    m_rate_clamped = expiry < earliest;
+    if (limit_reached(m_rate_clamped ? earliest : expiry)) {
+      finish_handler(gen);
+      return;
+    }
+    bool parked { arm(m_rate_clamped ? earliest : expiry) };
+    m_timer.async_wait( [gen, f = std::move(func), last_tp, tp, this]
+            (const std::error_code& e) mutable {
+        rate_handler_impl(gen, last_tp, tp, e, std::move(f));
       }
     );
+    leave_handler(parked);
+  }
+  // PI controller on the lateness of each callback against its ideal timepoint; the 
+  // integral term learns the systematic wake-up latency, and is not updated while 
+  // catching up (the lateness is then the backlog, not the latency)
+  static constexpr int rate_kp_div = 4;
+  static constexpr int rate_ki_div = 8;
+
+  void update_rate_correction(const duration& lateness, const duration& dur) {
+    if (m_rate_clamped || lateness >= dur / 2 || lateness <= -dur / 2) {
+      m_rate_correction = std::clamp(m_rate_integral / rate_ki_div, -dur / 2, dur / 2);
+      return;
+    }
+    duration limit { dur * rate_ki_div / 2 };
+    m_rate_integral = std::clamp(m_rate_integral + lateness, -limit, limit);
+    m_rate_correction = std::clamp(lateness / rate_kp_div + m_rate_integral / rate_ki_div,
+                                   -dur / 2, dur / 2);
+  }
+  void reset_rate_control(const time_point& last_callback) {
+    m_rate_integral = duration::zero();
+    m_rate_correction = duration::zero();
+    m_rate_clamped = false;
+    m_last_callback = last_callback;
+  }
+  template <typename F>
+  time_point next_timepoint(const time_point& tp) {
+    if constexpr (returns_delay<F>) {
+      return tp + m_next_delay;
+    }
+    duration dur { m_period.load(std::memory_order_relaxed) };
+    if (m_re_anchor.load(std::memory_order_relaxed) && 
+        m_re_anchor.exchange(false, std::memory_order_relaxed)) {
+      return Clock::now() + dur;
+    }
+    return tp + dur;
+  }
+
+  // true when a start option ends the timer instead of arming a wait for the expiry
+  bool limit_reached(const time_point& expiry) const noexcept {
+    return (m_max_ticks != 0u && m_ticks >= m_max_ticks) || expiry > m_until;
+  }
+  void apply_options(const options_type& opts) noexcept {
+    m_max_ticks = opts.max_ticks;
+    m_ticks = 0u;
+    m_until = opts.until;
+  }
+
+  // acquire the Asio timer for a handler, returns false if the handler belongs to a 
+  // previous start; pending requests are returned in flags
+  bool enter_handler(control_type gen, control_type& flags) {
+    control_type s { m_control.load(std::memory_order_acquire) };
+    for (;;) {
+      if ((s & gen_mask) != gen) {
+        return false;
+      }
+      if ((s & phase_mask) == busy) {
+        std::this_thread::yield(); // a start, cancel, pause or resume is finishing up
+        s = m_control.load(std::memory_order_acquire);
+        continue;
+      }
+      if (m_control.compare_exchange_weak(s, (s & ~phase_mask) | running,
+                                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+        m_handler_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        flags = s & flag_mask;
+        return true;
+      }
+    }
+  }
+  // invoke the function object with the Asio timer released (the callback phase), so 
+  // that a start, cancel, pause or resume from another thread doesn't wait for the 
+  // application code; callbacks are serialized, since a callback of a replaced start 
+  // may still be running, and cancel_flag is re-checked just before the invocation: a 
+  // tick is then replaced by the "operation aborted" notification, and the timer is 
+  // finished; returns false if the handler is done, i.e. finished, or replaced by a 
+  // start, otherwise the result of the function object is returned in more
+  template <typename F>
+  bool run_callback(control_type gen, F& func, std::error_code err, const duration& elap, 
+                    std::size_t expirations, bool& more) {
+    control_type s { m_control.load(std::memory_order_acquire) };
+    while (!m_control.compare_exchange_weak(s, (s & ~phase_mask) | in_callback,
+                                            std::memory_order_acq_rel, 
+                                            std::memory_order_acquire)) { }
+    while (m_callback_active.test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield(); // a callback of a replaced start is still running
+    }
+    s = m_control.load(std::memory_order_acquire);
+    if ((s & gen_mask) != gen) {
+      m_callback_active.clear(std::memory_order_release);
+      return false; // replaced by a start while waiting
+    }
+    bool cancelled { !err && (s & cancel_flag) };
+    if (cancelled) {
+      err = asio::error::operation_aborted;
+      expirations = 0u;
+    }
+    if constexpr (returns_delay<F> && !requires { F::returns_delay; }) {
+      std::optional<duration> next { invoke_with(func, m_state, err, elap, expirations) };
+      m_callback_active.clear(std::memory_order_release);
+      if (!end_callback(gen)) {
+        return false;
+      }
+      more = next.has_value();
+      if (more) {
+        m_next_delay = *next;
+      }
+    }
+    else {
+      more = invoke_with(func, m_state, err, elap, expirations);
+      m_callback_active.clear(std::memory_order_release);
+      if (!end_callback(gen)) {
+        return false;
+      }
+    }
+    if (cancelled) {
+      finish_handler(gen);
+      return false;
+    }
+    return true;
+  }
+  // take the Asio timer back after the function object returns, false if a start (from 
+  // within the callback or from another thread) owns the timer now
+  bool end_callback(control_type gen) {
+    control_type s { m_control.load(std::memory_order_acquire) };
+    for (;;) {
+      if ((s & gen_mask) != gen) {
+        return false;
+      }
+      if (m_control.compare_exchange_weak(s, (s & ~phase_mask) | running,
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return true;
+      }
+    }
+  }
+  // set the expiry of the Asio timer, a paused timer keeps its handler (and the function 
+  // object) parked in a wait that never expires, until woken by resume or cancel
+  bool arm(const time_point& tp) {
+    control_type s { m_control.load(std::memory_order_acquire) };
+    bool parked { (s & pause_flag) && !(s & resume_flag) };
+    m_timer.expires_at(parked ? time_point::max() : tp);
+    m_expiry.store(parked ? time_point::max() : tp, std::memory_order_relaxed);
+    if (m_jump_threshold.load(std::memory_order_relaxed) > duration::zero()) {
+      m_arm_time = Clock::now();
+      m_arm_steady = std::chrono::steady_clock::now();
+    }
+    return parked;
+  }
+  // true if clock_jumped was called, or if the clock has drifted from steady_clock by 
+  // more than the threshold since the Asio timer was armed
+  bool clock_jump(control_type flags, const time_point& now_time) {
+    if (flags & jump_flag) {
+      m_control.fetch_and(~jump_flag, std::memory_order_acq_rel);
+      return true;
+    }
+    duration threshold { m_jump_threshold.load(std::memory_order_relaxed) };
+    if (threshold <= duration::zero() || 
+        m_arm_steady == std::chrono::steady_clock::time_point()) {
+      return false;
+    }
+    duration steady_elap { std::chrono::duration_cast<duration>(
+                             std::chrono::steady_clock::now() - m_arm_steady) };
+    duration drift { (now_time - m_arm_time) - steady_elap };
+    return drift > threshold || drift < -threshold;
+  }
+  // release the Asio timer, either finishing the timer or leaving a wait pending; any 
+  // request that arrived while the handler was running (e.g. a cancel during the 
+  // callback) is handled by cancelling the wait, and the next handler acts on it
+  void finish_handler(control_type gen) {
+    if constexpr (stores_callback) {
+      m_callback.reset(); // release any resources held by the function object
+    }
+    m_handler_thread.store(std::thread::id(), std::memory_order_relaxed);
+    m_expiry.store(time_point::max(), std::memory_order_relaxed);
+    m_control.store(gen | idle, std::memory_order_release);
+  }
+  void leave_handler(bool parked) {
+    control_type s { m_control.load(std::memory_order_acquire) };
+    bool woken { false };
+    for (;;) {
+      bool park { (s & pause_flag) && !(s & resume_flag) };
+      if (!woken && ((s & cancel_flag) || park != parked || ((s & jump_flag) && !park))) {
+        m_timer.cancel();
+        woken = true;
+      }
+      if (m_control.compare_exchange_weak(s, (s & ~phase_mask) | armed,
+                                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return;
+      }
+    }
+  }
+  // for a parked handler, either stay parked or compute the resume timepoint
+  time_point paused_timepoint(control_type flags, const time_point& tp) {
+    if (!(flags & resume_flag)) {
+      return tp; // still paused
+    }
+    m_control.fetch_and(~(pause_flag | resume_flag), std::memory_order_acq_rel);
+    time_point now_time { Clock::now() };
+    duration dur { m_period.load(std::memory_order_relaxed) };
+    if (!m_skip_missed.load(std::memory_order_relaxed) || tp >= now_time || 
+        dur <= duration::zero()) {
+      return tp;
+    }
+    // skip the timepoints missed while paused, staying on the same timepoint sequence
+    return tp + ((now_time - tp) / dur + 1) * dur;
+  }
+
+  // set a request flag; a pending wait is cancelled so that its handler acts on the 
+  // request, while a running handler acts on it before re-arming, or (for a cancel) 
+  // instead of invoking the callback if the callback phase has not started
+  void request(control_type flag) {
+    check_thread();
+    control_type s { m_control.load(std::memory_order_acquire) };
+    for (;;) {
+      if ((s & flag) || (s & cancel_flag) || 
+          (flag == resume_flag && !(s & pause_flag))) {
+        return; // nothing to do
+      }
+      switch (s & phase_mask) {
+        case idle:
+          return;
+        case busy:
+          std::this_thread::yield();
+          s = m_control.load(std::memory_order_acquire);
+          break;
+        case running:
+        case in_callback:
+          if (m_control.compare_exchange_weak(s, s | flag,
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+          }
+          break;
+        case armed:
+          if (flag == jump_flag && (s & pause_flag)) {
+            // a paused handler acts on it after the resume
+            if (m_control.compare_exchange_weak(s, s | flag,
+                                              std::memory_order_acq_rel, std::memory_order_acquire)) {
+              return;
+            }
+            break;
+          }
+          if (m_control.compare_exchange_weak(s, (s & ~phase_mask) | flag | busy,
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            m_timer.cancel();
+            // nothing else changes the state while busy
+            m_control.store((s & ~phase_mask) | flag | armed, std::memory_order_release);
+            return;
+          }
+          break;
+      }
+    }
+  }
+  // acquire the Asio timer for a start, the new generation is returned in gen; waits for 
+  // the short windows in which a handler or another call owns the timer, while a handler 
+  // running the function object is replaced without waiting, unless the function object 
+  // is stored in the timer: it then can't be replaced from within the callback, and a 
+  // start from another thread waits for the callback to return
+  bool acquire_for_start(control_type& gen) {
+    check_thread();
+    control_type s { m_control.load(std::memory_order_acquire) };
+    for (;;) {
+      control_type phase { s & phase_mask };
+      if constexpr (stores_callback) {
+        if (phase == in_callback && 
+            m_handler_thread.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+          return false; // a stored function object can't be replaced while it is running
+        }
+      }
+      if (phase == busy || phase == running || (stores_callback && phase == in_callback)) {
+        std::this_thread::yield();
+        s = m_control.load(std::memory_order_acquire);
+        continue;
+      }
+      gen = (s & gen_mask) + gen_one;
+      if (m_control.compare_exchange_weak(s, gen | busy,
+                                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return true;
+      }
+    }
   }
 
 public:
@@ -153,11 +925,74 @@ public:
    *
    * The @c duration parameter provides an elapsed time from the previous callback.
    *
+   * Alternatively the function object can accept the number of timer expirations since 
+   * the previous callback:
+   * @code
+   *   bool (std::error_code, duration, std::size_t);
+   * @endcode
+   *
+   * For a timepoint timer that has fallen behind (e.g. the thread was stalled), a 
+   * function object with this signature is invoked once with the number of timepoints 
+   * that have passed, rather than once for each timepoint in quick succession. The count 
+   * is always 1 for a duration timer, and 0 for the "operation aborted" notification.
+   *
+   * Instead of @c bool, the function object can return @c std::optional<duration>, 
+   * for a delay that changes from one invocation to the next (e.g. an adaptive backoff) 
+   * without restarting the timer:
+   * @code
+   *   std::optional<duration> (std::error_code, duration);
+   * @endcode
+   *
+   * An empty optional finishes the timer, the same as returning @c false. A value is 
+   * used instead of the period for the next interval only: a duration timer is re-armed 
+   * for the delay after the callback, and a timepoint or rate timer's next timepoint is 
+   * the delay after the current one. The choice is made at compile time, so a @c bool 
+   * returning function object has no extra cost. After a clock jump the timer is 
+   * re-anchored with the period.
+   *
+   * When the @c State template parameter is not @c void, the timer holds a @c State 
+   * object next to the Asio timer, and the function object can take a reference to it 
+   * as the first parameter, instead of capturing (and moving) per-timer state:
+   * @code
+   *   bool (State&, std::error_code, duration);
+   *   bool (State&, std::error_code, duration, std::size_t);
+   * @endcode
+   *
+   * When the @c CallbackCapacity template parameter is not zero, the function object 
+   * is stored inside the timer. A function object larger than the capacity is a compile 
+   * time error. Since a stored function object is replaced by a new @c start, there is 
+   * no "operation aborted" notification for a timer replaced by @c start, and a 
+   * @c start called from within the callback is rejected (it returns @c false).
+   *
+   * The @c WaitTraits and @c Executor template parameters are passed through to the 
+   * @c asio::basic_waitable_timer. A concrete executor type (e.g. 
+   * @c asio::io_context::executor_type) avoids the type-erased @c asio::any_io_executor 
+   * indirection on each wait, and custom wait traits can e.g. round wait durations so 
+   * that the operating system can coalesce timer wake-ups. The type-erased executor 
+   * is the default so that timers on different executors have the same type.
+   *
    * The clock for the asynchronous timer defaults to @c std::chrono::steady_clock.
    * Other clock types can be used if desired (e.g. @c std::chrono::high_resolution_clock 
    * or @c std::chrono::system_clock). Note that some clocks allow time to be externally 
    * adjusted, which may influence the interval between the callback invocation.
    *
+   * The @c start, @c cancel, @c pause, @c resume and @c set_period methods can be called 
+   * from any thread, including when the @c io_context is run from multiple threads, 
+   * without a strand, and none of them waits for a callback in progress. A @c start 
+   * called while the callback runs (from within it or from another thread) replaces 
+   * the running timer, with no "operation aborted" notification; the callbacks of the 
+   * new start are not invoked until the running callback returns. A function object 
+   * stored in the timer (see @c CallbackCapacity) is the exception: it is only 
+   * replaced after the callback returns, so a @c start from another thread waits for 
+   * the callback, and a @c start from within it returns @c false.
+   *
+   * When the @c io_context is run by a single thread, it can be constructed with the 
+   * @c ASIO_CONCURRENCY_HINT_UNSAFE concurrency hint (see @c periodic_timer_runner), 
+   * which removes the Asio internal locking from each wait. All methods must then be 
+   * called from within the callback, or before the @c io_context is run. For the 
+   * @c io_context of a @c periodic_timer_runner, an assertion in debug builds catches a 
+   * call from another thread while a handler is live.
+   *
    * Move semantics are allowed for this type, but not copy semantics. When a move 
    * construction or move assignment completes, all timers are cancelled with 
    * appropriate notification, and @c start will need to be called.
@@ -165,7 +1000,51 @@ public:
    * @param ioc @c io_context for asynchronous processing.
    *
    */
-  explicit periodic_timer(asio::io_context& ioc) noexcept : m_timer(ioc) { }
+  explicit periodic_timer(asio::io_context& ioc) 
+        noexcept(std::is_nothrow_default_constructible_v<state_type>) : 
+      m_timer(ioc), m_state(), m_period(duration::zero()), m_re_anchor(false),
+      m_skip_missed(true), m_control(idle), m_handler_thread() { }
+
+  /**
+   * Construct a @c periodic_timer with an @c io_context, constructing the @c State 
+   * object from the supplied arguments.
+   *
+   * @param ioc @c io_context for asynchronous processing.
+   *
+   * @param args Arguments forwarded to the @c State constructor.
+   *
+   */
+  template <typename... Args>
+  periodic_timer(asio::io_context& ioc, std::in_place_t, Args&&... args) : 
+      m_timer(ioc), m_state(std::forward<Args>(args)...), m_period(duration::zero()), 
+      m_re_anchor(false), m_skip_missed(true), m_control(idle), m_handler_thread() { }
+
+  /**
+   * Construct a @c periodic_timer with an executor, otherwise the same as the 
+   * @c io_context constructor.
+   *
+   * @param ex Executor for asynchronous processing, e.g. from @c io_context::get_executor 
+   * or an @c asio::strand.
+   *
+   */
+  explicit periodic_timer(const executor_type& ex) 
+        noexcept(std::is_nothrow_default_constructible_v<state_type>) : 
+      m_timer(ex), m_state(), m_period(duration::zero()), m_re_anchor(false),
+      m_skip_missed(true), m_control(idle), m_handler_thread() { }
+
+  /**
+   * Construct a @c periodic_timer with an executor, constructing the @c State object 
+   * from the supplied arguments.
+   *
+   * @param ex Executor for asynchronous processing.
+   *
+   * @param args Arguments forwarded to the @c State constructor.
+   *
+   */
+  template <typename... Args>
+  periodic_timer(const executor_type& ex, std::in_place_t, Args&&... args) : 
+      m_timer(ex), m_state(std::forward<Args>(args)...), m_period(duration::zero()), 
+      m_re_anchor(false), m_skip_missed(true), m_control(idle), m_handler_thread() { }
 
   periodic_timer() = delete; // no default ctor
 
@@ -174,10 +1053,23 @@ public:
   periodic_timer& operator=(const periodic_timer&) = delete;
 
   // allow move construction and move assignment
-  periodic_timer(periodic_timer&&) = default;
+  periodic_timer(periodic_timer&& rhs) 
+        noexcept(std::is_nothrow_move_constructible_v<state_type>) : 
+      m_timer(std::move(rhs.m_timer)), m_state(std::move(rhs.m_state)),
+      m_callback(std::move(rhs.m_callback)),
+      m_period(rhs.m_period.load(std::memory_order_relaxed)),
+      m_re_anchor(rhs.m_re_anchor.load(std::memory_order_relaxed)),
+      m_skip_missed(rhs.m_skip_missed.load(std::memory_order_relaxed)),
+      m_control(idle), m_handler_thread() { }
   periodic_timer& operator=(periodic_timer&& rhs) {
-    m_timer.cancel();
+    cancel();
     m_timer = std::move(rhs.m_timer);
+    m_state = std::move(rhs.m_state);
+    m_callback = std::move(rhs.m_callback);
+    m_period.store(rhs.m_period.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_re_anchor.store(rhs.m_re_anchor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_skip_missed.store(rhs.m_skip_missed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
   }
 
   // modifying methods
@@ -192,14 +1084,16 @@ public:
    *
    * @param func Function object to be invoked. 
    *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
    */
   template <typename F>
-  void start_duration_timer(const duration& dur, F&& func) {
-    m_timer.expires_after(dur);
-    m_timer.async_wait( [dur, f = std::move(func), this] (const std::error_code& e) {
-        duration_handler_impl(Clock::now(), dur, e, std::move(f));
-      }
-    );
+  bool start_duration_timer(const duration& dur, F&& func, 
+                            const options_type& opts = options_type()) {
+    return start_duration_timer(dur, (Clock::now() + dur), std::forward<F>(func), opts);
   }
   /**
    * Start the timer, and the application supplied function object will be invoked 
@@ -214,14 +1108,23 @@ public:
    *
    * @param func Function object to be invoked.
    *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
    */
   template <typename F>
-  void start_duration_timer(const duration& dur, const time_point& when, F&& func) {
-    m_timer.expires_at(when);
-    m_timer.async_wait( [dur, f = std::move(func), this] (const std::error_code& e) {
-        duration_handler_impl(Clock::now(), dur, e, std::move(f));
-      }
-    );
+  bool start_duration_timer(const duration& dur, const time_point& when, F&& func, 
+                            const options_type& opts = options_type()) {
+    control_type gen { };
+    if (!acquire_for_start(gen)) {
+      return false;
+    }
+    m_period.store(dur, std::memory_order_relaxed);
+    apply_options(opts);
+    duration_wait(gen, Clock::now(), when, prepare_callback(std::forward<F>(func)));
+    return true;
   }
   /**
    * Start the timer, and the application supplied function object will be invoked 
@@ -233,10 +1136,16 @@ public:
    *
    * @param func Function object to be invoked. 
    *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
    */
   template <typename F>
-  void start_timepoint_timer(const duration& dur, F&& func) {
-    start_timepoint_timer(dur, (Clock::now() + dur), std::forward<F>(func));
+  bool start_timepoint_timer(const duration& dur, F&& func, 
+                             const options_type& opts = options_type()) {
+    return start_timepoint_timer(dur, (Clock::now() + dur), std::forward<F>(func), opts);
   }
   /**
    * Start the timer on the specified timepoint, and the application supplied function object 
@@ -250,28 +1159,259 @@ public:
    *
    * @param func Function object to be invoked. 
    *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
    * @note The elapsed time for the first callback invocation is artificially set to the 
    * duration interval.
    */
   template <typename F>
-  void start_timepoint_timer(const duration& dur, const time_point& when, F&& func) {
-    m_timer.expires_at(when);
-    m_timer.async_wait( [when, dur, f = std::move(func), this]
-            (const std::error_code& e) {
-        timepoint_handler_impl((when-dur), dur, e, std::move(f));
-      }
-    );
+  bool start_timepoint_timer(const duration& dur, const time_point& when, F&& func, 
+                             const options_type& opts = options_type()) {
+    control_type gen { };
+    if (!acquire_for_start(gen)) {
+      return false;
+    }
+    m_period.store(dur, std::memory_order_relaxed);
+    m_re_anchor.store(false, std::memory_order_relaxed);
+    apply_options(opts);
+    timepoint_wait(gen, (when-dur), when, prepare_callback(std::forward<F>(func)));
+    return true;
+  }
+
+  /**
+   * Start a rate timer, and the application supplied function object will be invoked 
+   * at an average rate of one invocation per duration, with at least the minimum gap 
+   * between the start of consecutive invocations.
+   *
+   * A duration timer adds the callback processing time and the wake-up latency to each 
+   * interval, so its rate is lower than intended. A timepoint timer holds the rate, but 
+   * invokes the callback in quick succession after falling behind. A rate timer follows 
+   * the same timepoint sequence as a timepoint timer, but:
+   * - each wait is armed ahead of the timepoint by a correction from a proportional-
+   *   integral controller on the lateness of previous callbacks, so that systematic 
+   *   wake-up latency is compensated and callbacks happen close to their timepoints
+   * - after falling behind, the missed timepoints are caught up with the callbacks 
+   *   spaced by the minimum gap, so the long-run average rate is still exact.
+   *
+   * The function object is invoked once for each timepoint, and an expiration count 
+   * parameter is always 1. The elapsed time is the same as for a timepoint timer.
+   *
+   * The function object will continue to be invoked as long as it returns @c true.
+   *
+   * @param dur Interval between timepoints, i.e. the inverse of the target rate.
+   *
+   * @param min_gap Minimum time between the start of consecutive callbacks, which should 
+   * be less than the duration so that a backlog can be caught up.
+   *
+   * @param func Function object to be invoked.
+   *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
+   */
+  template <typename F>
+  bool start_rate_timer(const duration& dur, const duration& min_gap, F&& func, 
+                        const options_type& opts = options_type()) {
+    return start_rate_timer(dur, min_gap, (Clock::now() + dur), std::forward<F>(func), opts);
+  }
+  /**
+   * Start a rate timer on the specified timepoint, otherwise the same as above.
+   *
+   * @param dur Interval between timepoints.
+   *
+   * @param min_gap Minimum time between the start of consecutive callbacks.
+   *
+   * @param when Time point when the first timer callback will be invoked.
+   *
+   * @param func Function object to be invoked.
+   *
+   * @param opts Optional stop conditions, see @c start_options.
+   *
+   * @return @c false, with no change to the timer, if the function object is stored 
+   * in the timer and the call is made from within the callback.
+   *
+   */
+  template <typename F>
+  bool start_rate_timer(const duration& dur, const duration& min_gap, const time_point& when, 
+                        F&& func, const options_type& opts = options_type()) {
+    control_type gen { };
+    if (!acquire_for_start(gen)) {
+      return false;
+    }
+    m_period.store(dur, std::memory_order_relaxed);
+    m_re_anchor.store(false, std::memory_order_relaxed);
+    apply_options(opts);
+    m_min_gap = min_gap;
+    reset_rate_control(when - min_gap); // the first expiry is not held back
+    rate_wait(gen, (when-dur), when, prepare_callback(std::forward<F>(func)));
+    return true;
+  }
+
+  /**
+   * Change the interval between callback invocations without cancelling and restarting 
+   * the timer. The new period takes effect on the next re-arm, i.e. after the currently 
+   * pending wait completes and the callback returns.
+   *
+   * This method can be called from within the callback, or from any other thread.
+   *
+   * @param dur New interval to be used between callback invocations.
+   *
+   * @param pc For timepoint timers, whether the timepoint sequence continues from the 
+   * last scheduled timepoint (the default) or is re-anchored to the time of the re-arm.
+   */
+  void set_period(const duration& dur, period_change pc = period_change::preserve_phase) {
+    m_period.store(dur, std::memory_order_relaxed);
+    if (pc == period_change::re_anchor) {
+      m_re_anchor.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Return the interval currently used between callback invocations.
+   */
+  duration get_period() const noexcept {
+    return m_period.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Pause the timer. The application function object is not invoked while the timer is 
+   * paused, and it is not notified of the pause.
+   *
+   * The function object and the timepoint sequence are kept by the timer, so @c resume 
+   * continues where the timer left off without the function object being moved back in 
+   * through a @c start method.
+   *
+   * Calling @c pause on a timer that is already paused, or on a timer that is not 
+   * running, has no effect.
+   *
+   * This method can be called from within the callback, or from any other thread.
+   */
+  void pause() {
+    request(pause_flag);
+  }
+
+  /**
+   * Resume a paused timer. The timer is re-armed for the timepoint (or duration expiry) 
+   * that was pending when the timer was paused.
+   *
+   * This method can be called from within the callback, or from any other thread.
+   *
+   * @param skip_missed If @c true, timepoints that passed while the timer was paused are 
+   * skipped, and the timer is re-armed for the next timepoint in the same sequence. If 
+   * @c false, the pending timepoint is kept, and any timepoints that passed while paused 
+   * are invoked in quick succession, as for an overflowing timepoint timer.
+   *
+   * Calling @c resume on a timer that is not paused has no effect.
+   */
+  void resume(bool skip_missed = true) {
+    m_skip_missed.store(skip_missed, std::memory_order_relaxed);
+    request(resume_flag);
+  }
+
+  /**
+   * Return a reference to the @c State object. For a timer without a @c State (the 
+   * default), an empty placeholder object is returned.
+   *
+   * The @c State object is accessed by the callback on the thread running the handler, 
+   * and any other access must be synchronized by the application.
+   */
+  state_type& get_state() noexcept {
+    return m_state;
+  }
+  const state_type& get_state() const noexcept {
+    return m_state;
+  }
+
+  /**
+   * Enable detection of clock jumps (e.g. an NTP step of @c std::chrono::system_clock), 
+   * by comparing the time elapsed on the timer clock against @c std::chrono::steady_clock 
+   * at each expiry. When they differ by more than the threshold, the function object is 
+   * invoked with a @c chops::timer_errc::clock_jump error code and an expiration count 
+   * of 0, and the timepoint sequence (or the duration wait) is re-anchored to the 
+   * current time instead of catching up with a burst of invocations. If the function 
+   * object returns @c false the timer finishes. Note that the elapsed time passed for 
+   * the jump notification spans the jump, and may be negative.
+   *
+   * A backward jump is only detected on the next expiry, which is delayed by the size 
+   * of the jump. To avoid this, call @c clock_jumped when the system reports a clock 
+   * change (e.g. through @c clock_jump_notifier on Linux).
+   *
+   * This method can be called from any thread, and applies from the next wait.
+   *
+   * @param threshold Allowed drift between the clocks over one wait, zero (the default) 
+   * disables the detection.
+   */
+  void set_clock_jump_threshold(const duration& threshold) noexcept {
+    m_jump_threshold.store(threshold, std::memory_order_relaxed);
+  }
+
+  /**
+   * Notify the timer that its clock has been stepped. A pending wait is woken, and the 
+   * function object is invoked with a @c chops::timer_errc::clock_jump error code as 
+   * described for @c set_clock_jump_threshold. For a paused timer the notification is 
+   * delivered after @c resume.
+   *
+   * This method can be called from any thread, and does not require a threshold.
+   */
+  void clock_jumped() {
+    request(jump_flag);
+  }
+
+  /**
+   * Return the executor of the Asio timer.
+   */
+  executor_type get_executor() noexcept {
+    return m_timer.get_executor();
+  }
+
+  /**
+   * Return the time point of the pending timer expiry, or @c time_point::max() if the 
+   * timer is not running or is paused. Can be called from any thread, e.g. by a 
+   * @c periodic_timer_runner spinning until the next expiry.
+   */
+  time_point next_expiry() const noexcept {
+    return m_expiry.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return @c true if the timer is paused.
+   */
+  bool is_paused() const noexcept {
+    return (m_control.load(std::memory_order_acquire) & pause_flag) != 0u;
+  }
+
+  /**
+   * Return @c true if the timer has been started and has not yet finished, i.e. a wait 
+   * is pending or a handler is running. Once this returns @c false after the timer has 
+   * finished, no handler accesses the @c periodic_timer object any more.
+   */
+  bool is_running() const noexcept {
+    return (m_control.load(std::memory_order_acquire) & phase_mask) != idle;
   }
 
   /**
    * Cancel the timer. The application function object will be called with an 
    * "operation aborted" error code.
    *
+   * This method can be called from within the callback, or from any other thread, 
+   * including while @c io_context::run is invoked from multiple threads, and doesn't wait 
+   * for a callback in progress. No callback for a timer expiry starts after @c cancel 
+   * returns; the only invocation of the function object after @c cancel returns (other 
+   * than a callback that had already started when @c cancel was called) is the 
+   * "operation aborted" notification.
+   *
+   * A paused timer can be cancelled, and the function object will be called as above.
+   *
    * A cancel may implicitly be called if the @c periodic_timer object is move copy 
    * constructed or move assigned.
    */
   void cancel() {
-    m_timer.cancel();
+    request(cancel_flag);
   }
 };
 
@@ -0,0 +1,486 @@
+/** @file
+ *
+ * @brief A thread with its own @c io_context, for running @c periodic_timer objects.
+ *
+ * Running timers requires an @c io_context, an @c executor_work_guard so that
+ * @c run does not return while no timers are started, and a thread calling @c run.
+ * @c periodic_timer_runner packages these, and optionally configures the thread for
+ * low jitter:
+ *
+ * - @c cpu pins the thread to a CPU core.
+ * - @c fifo_priority runs the thread with the @c SCHED_FIFO real-time policy (this
+ *   normally requires privileges, e.g. @c CAP_SYS_NICE).
+ * - @c lock_memory locks the process memory with @c mlockall, so that page faults do
+ *   not delay the callbacks (this affects the whole process).
+ * - @c concurrency_hint is passed to the @c io_context. The default of 1 tells Asio
+ *   that only one thread runs the @c io_context, which allows some internal locking to
+ *   be avoided.
+ * - @c mode selects how the thread runs the @c io_context (see below).
+ *
+ * The run modes are:
+ *
+ * - @c blocking calls @c io_context::run, sleeping in the kernel between expiries.
+ * - @c busy_poll calls @c io_context::poll in a loop, which avoids the wake-up latency
+ *   at the cost of a fully used core, but still makes a (non-blocking) system call on
+ *   each poll.
+ * - @c spin spins on @c std::chrono::steady_clock (read through the vDSO on Linux, with
+ *   no system call) until the earliest expiry of the timers registered with @c watch,
+ *   then polls. Between expiries the @c io_context is only polled every
+ *   @c idle_poll_interval, for other work such as @c post or a @c cancel notification.
+ *   Intended for a core isolated from the scheduler (e.g. @c isolcpus).
+ * - @c hybrid is as @c spin, but blocks in the @c io_context when the next expiry is
+ *   further away than @c spin_threshold, spinning only for the last part of the wait.
+ *
+ * In the @c spin and @c hybrid modes the runner reports the duty cycle (the fraction of
+ * time spent running handlers) and the lateness of expiry dispatch through
+ * @c get_stats.
+ *
+ * With @c concurrency_hint set to @c single_threaded_hint (@c ASIO_CONCURRENCY_HINT_UNSAFE)
+ * Asio does no internal locking at all, which saves a mutex lock and unlock on each
+ * timer wait and completion. Timers must then only be used from within their callbacks,
+ * or before @c start is called (and @c periodic_timer asserts this in debug builds). The
+ * runner thread itself checks for @c join and @c stop requests, so these can still be
+ * called from any thread.
+ *
+ * The CPU, priority and memory options are only supported on Linux, elsewhere
+ * requesting them results in an error from @c start.
+ *
+ * @code
+ *   chops::periodic_timer_runner runner { chops::runner_options { .cpu = 3 } };
+ *   if (auto err = runner.start(); err) {
+ *     // handle error
+ *   }
+ *   chops::periodic_timer<> timer { runner.get_io_context() };
+ *   timer.start_timepoint_timer(1ms, func);
+ *   // ...
+ *   runner.join(); // waits for the timer to finish
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef PERIODIC_TIMER_RUNNER_HPP_INCLUDED
+#define PERIODIC_TIMER_RUNNER_HPP_INCLUDED
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t, std::int64_t
+#include <future> // std::promise
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h> // _mm_pause
+#endif
+
+#include "timer/periodic_timer.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h> // mlockall
+#include <cerrno>
+#endif
+
+namespace chops {
+
+/**
+ * Concurrency hint for an @c io_context that is only used by a single thread, with Asio
+ * internal locking disabled.
+ */
+inline constexpr int single_threaded_hint = ASIO_CONCURRENCY_HINT_UNSAFE;
+
+/**
+ * How the runner thread runs the @c io_context.
+ */
+enum class run_mode { blocking, busy_poll, spin, hybrid };
+
+/**
+ * Configuration of a @c periodic_timer_runner thread.
+ */
+struct runner_options {
+  int      cpu { -1 };              // CPU core to pin the thread to, negative for none
+  int      fifo_priority { 0 };     // SCHED_FIFO priority, 0 to keep the default policy
+  bool     lock_memory { false };   // lock process memory with mlockall
+  int      concurrency_hint { 1 };  // io_context concurrency hint
+  run_mode mode { run_mode::blocking };
+  // spin and hybrid modes: how often the io_context is polled while waiting for an expiry
+  std::chrono::nanoseconds idle_poll_interval { std::chrono::milliseconds(1) };
+  // hybrid mode: block when the next expiry is further away than this
+  std::chrono::nanoseconds spin_threshold { std::chrono::microseconds(200) };
+};
+
+/**
+ * Statistics of a @c periodic_timer_runner in the @c spin or @c hybrid modes, since
+ * the last @c start.
+ */
+struct runner_stats {
+  std::uint64_t            ticks { 0u };           // polls for a watched timer expiry
+  std::chrono::nanoseconds max_lateness { 0 };     // expiry to dispatch
+  std::chrono::nanoseconds total_lateness { 0 };
+  std::chrono::nanoseconds busy_time { 0 };        // time spent in polls that ran handlers
+  std::chrono::nanoseconds run_time { 0 };         // time spent in the run loop
+
+  std::chrono::nanoseconds mean_lateness() const noexcept {
+    return ticks == 0u ? std::chrono::nanoseconds(0) : 
+                         total_lateness / static_cast<std::int64_t>(ticks);
+  }
+  double duty_cycle() const noexcept {
+    return run_time.count() == 0 ? 0.0 : 
+           static_cast<double>(busy_time.count()) / static_cast<double>(run_time.count());
+  }
+};
+
+class periodic_timer_runner {
+private:
+
+  using work_guard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+  enum shutdown_request { no_request, join_request, stop_request };
+
+  // how often a single-threaded runner checks for a join or stop request while blocked
+  static constexpr std::chrono::milliseconds request_check_interval { 10 };
+
+  using clock = std::chrono::steady_clock;
+
+  struct watched_timer {
+    const void* m_timer;
+    clock::time_point (*m_next_expiry)(const void*) noexcept;
+  };
+
+  runner_options             m_options;
+  asio::io_context           m_ioc;
+  std::optional<work_guard>  m_wg;
+  std::thread                m_thr;
+  bool                       m_single_threaded;
+  std::atomic<int>           m_request;
+  std::vector<watched_timer> m_watched;
+
+  // statistics, written by the runner thread and readable from any thread
+  std::atomic<std::uint64_t> m_ticks;
+  std::atomic<std::int64_t>  m_max_lateness;
+  std::atomic<std::int64_t>  m_total_lateness;
+  std::atomic<std::int64_t>  m_busy_time;
+  std::atomic<std::int64_t>  m_run_time;
+
+private:
+
+  // applied from within the runner thread
+  std::error_code configure_thread() const {
+#ifdef __linux__
+    if (m_options.cpu >= 0) {
+      if (m_options.cpu >= CPU_SETSIZE) {
+        return std::make_error_code(std::errc::invalid_argument);
+      }
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(m_options.cpu, &cpus);
+      if (int r = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus); r != 0) {
+        return std::error_code(r, std::system_category());
+      }
+    }
+    if (m_options.fifo_priority > 0) {
+      sched_param param { };
+      param.sched_priority = m_options.fifo_priority;
+      if (int r = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param); r != 0) {
+        return std::error_code(r, std::system_category());
+      }
+    }
+#else
+    if (m_options.cpu >= 0 || m_options.fifo_priority > 0) {
+      return std::make_error_code(std::errc::operation_not_supported);
+    }
+#endif
+    return std::error_code();
+  }
+
+  // the io_context of a single-threaded runner can't be stopped or have its work guard 
+  // released from another thread, so the run loop acts on the requests
+  void check_request() {
+    if (!m_single_threaded) {
+      return;
+    }
+    switch (m_request.load(std::memory_order_acquire)) {
+      case join_request:
+        m_wg.reset();
+        break;
+      case stop_request:
+        m_ioc.stop();
+        break;
+    }
+  }
+
+  static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+  }
+
+  clock::time_point next_expiry() const noexcept {
+    clock::time_point next { clock::time_point::max() };
+    for (const auto& w : m_watched) {
+      next = std::min(next, w.m_next_expiry(w.m_timer));
+    }
+    return next;
+  }
+
+  static std::int64_t to_ns(clock::duration d) noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  }
+
+  // returns the number of handlers run, accumulating the time spent running them
+  std::size_t timed_poll(clock::time_point start) {
+    std::size_t n { m_ioc.poll() };
+    if (n != 0u) {
+      m_busy_time.fetch_add(to_ns(clock::now() - start), std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  void run_spin() {
+    clock::time_point run_start { clock::now() };
+    clock::time_point last_poll { run_start };
+    clock::time_point last_dispatched { clock::time_point::min() };
+    while (!m_ioc.stopped()) {
+      clock::time_point now { clock::now() };
+      clock::time_point next { next_expiry() };
+      if (now >= next) {
+        // keep polling until the reactor reports the expiry, lateness is measured to 
+        // the poll that dispatches it
+        if (timed_poll(now) != 0u && next != last_dispatched) {
+          last_dispatched = next;
+          std::int64_t late { to_ns(now - next) };
+          m_ticks.fetch_add(1u, std::memory_order_relaxed);
+          m_total_lateness.fetch_add(late, std::memory_order_relaxed);
+          if (late > m_max_lateness.load(std::memory_order_relaxed)) {
+            m_max_lateness.store(late, std::memory_order_relaxed);
+          }
+        }
+        last_poll = now;
+      }
+      else if (m_options.mode == run_mode::hybrid && next - now > m_options.spin_threshold) {
+        clock::time_point until { std::min(now + request_check_interval,
+            next - std::chrono::duration_cast<clock::duration>(m_options.spin_threshold)) };
+        if (m_ioc.run_one_until(until) != 0u) {
+          m_busy_time.fetch_add(to_ns(clock::now() - now), std::memory_order_relaxed);
+        }
+        last_poll = clock::now();
+      }
+      else if (now - last_poll >= m_options.idle_poll_interval) {
+        timed_poll(now);
+        last_poll = now;
+      }
+      else {
+        cpu_relax();
+      }
+      check_request();
+      m_run_time.store(to_ns(clock::now() - run_start), std::memory_order_relaxed);
+    }
+  }
+
+  void run() {
+    if (m_options.mode == run_mode::spin || m_options.mode == run_mode::hybrid) {
+      run_spin();
+    }
+    else if (m_single_threaded) {
+      while (!m_ioc.stopped()) {
+        if (m_options.mode == run_mode::busy_poll) {
+          m_ioc.poll();
+        }
+        else {
+          m_ioc.run_one_for(request_check_interval);
+        }
+        check_request();
+      }
+    }
+    else if (m_options.mode == run_mode::busy_poll) {
+      // poll returns 0 and the io_context is stopped when there is no more work
+      while (m_ioc.poll() != 0u || !m_ioc.stopped()) { }
+    }
+    else {
+      m_ioc.run();
+    }
+  }
+
+  void finish(shutdown_request req) {
+    if (!m_thr.joinable()) {
+      m_wg.reset();
+      return;
+    }
+    if (m_single_threaded) {
+      m_request.store(req, std::memory_order_release);
+    }
+    else if (req == stop_request) {
+      m_ioc.stop();
+    }
+    else {
+      m_wg.reset();
+    }
+    m_thr.join();
+    m_wg.reset();
+  }
+
+public:
+
+  /**
+   * Construct the runner, which creates the @c io_context. The thread is not created
+   * until @c start is called.
+   *
+   * @param opts Thread and @c io_context configuration.
+   */
+  explicit periodic_timer_runner(const runner_options& opts = runner_options { }) :
+    m_options(opts), m_ioc(opts.concurrency_hint), m_wg(), m_thr(),
+    m_single_threaded(!ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, opts.concurrency_hint)),
+    m_request(no_request), m_watched(), m_ticks(0u), m_max_lateness(0), 
+    m_total_lateness(0), m_busy_time(0), m_run_time(0) {
+    if (m_single_threaded) {
+      asio::make_service<detail::single_threaded_marker>(m_ioc);
+    }
+  }
+
+  periodic_timer_runner(const periodic_timer_runner&) = delete;
+  periodic_timer_runner& operator=(const periodic_timer_runner&) = delete;
+
+  /**
+   * Stop the @c io_context and join the thread, if running.
+   */
+  ~periodic_timer_runner() {
+    stop();
+  }
+
+  /**
+   * Return the @c io_context, to be passed to @c periodic_timer constructors.
+   */
+  asio::io_context& get_io_context() noexcept {
+    return m_ioc;
+  }
+
+  /**
+   * Return the @c io_context executor.
+   */
+  asio::io_context::executor_type get_executor() noexcept {
+    return m_ioc.get_executor();
+  }
+
+  /**
+   * Register a timer whose expiries the @c spin and @c hybrid modes wait for. Timers 
+   * must be registered before @c start, and a registered timer must not be destroyed 
+   * before the runner thread is joined. Timers that are not registered are still run, 
+   * but only dispatched on the periodic polls.
+   *
+   * @param timer A @c periodic_timer on @c std::chrono::steady_clock.
+   */
+  template <typename State, std::size_t CallbackCapacity, typename WaitTraits, typename Executor>
+  void watch(const periodic_timer<clock, State, CallbackCapacity, WaitTraits, Executor>& timer) {
+    using timer_type = periodic_timer<clock, State, CallbackCapacity, WaitTraits, Executor>;
+    m_watched.push_back(watched_timer { &timer, 
+        [] (const void* t) noexcept { return static_cast<const timer_type*>(t)->next_expiry(); } });
+  }
+
+  /**
+   * Return the statistics since the last @c start, for the @c spin and @c hybrid modes.
+   * Can be called from any thread.
+   */
+  runner_stats get_stats() const noexcept {
+    using std::chrono::nanoseconds;
+    runner_stats st;
+    st.ticks = m_ticks.load(std::memory_order_relaxed);
+    st.max_lateness = nanoseconds(m_max_lateness.load(std::memory_order_relaxed));
+    st.total_lateness = nanoseconds(m_total_lateness.load(std::memory_order_relaxed));
+    st.busy_time = nanoseconds(m_busy_time.load(std::memory_order_relaxed));
+    st.run_time = nanoseconds(m_run_time.load(std::memory_order_relaxed));
+    return st;
+  }
+
+  /**
+   * Create the thread, apply the options, and start running the @c io_context.
+   * Returns once the options have been applied.
+   *
+   * A runner can be started again after @c join or @c stop.
+   *
+   * @return An error if the runner is already running, or if an option could not be
+   * applied, in which case the thread is not running.
+   */
+  std::error_code start() {
+    if (m_thr.joinable()) {
+      return std::make_error_code(std::errc::operation_in_progress);
+    }
+    if (m_options.lock_memory) {
+#ifdef __linux__
+      if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        return std::error_code(errno, std::system_category());
+      }
+#else
+      return std::make_error_code(std::errc::operation_not_supported);
+#endif
+    }
+    m_ioc.restart();
+    m_wg.emplace(asio::make_work_guard(m_ioc));
+    m_request.store(no_request, std::memory_order_relaxed);
+    m_ticks.store(0u, std::memory_order_relaxed);
+    m_max_lateness.store(0, std::memory_order_relaxed);
+    m_total_lateness.store(0, std::memory_order_relaxed);
+    m_busy_time.store(0, std::memory_order_relaxed);
+    m_run_time.store(0, std::memory_order_relaxed);
+    std::promise<std::error_code> configured;
+    auto result { configured.get_future() };
+    m_thr = std::thread([this, configured = std::move(configured)] () mutable {
+        auto err { configure_thread() };
+        configured.set_value(err);
+        if (!err) {
+          run();
+        }
+      }
+    );
+    auto err { result.get() };
+    if (err) {
+      m_thr.join();
+      m_wg.reset();
+    }
+    return err;
+  }
+
+  /**
+   * Release the work guard and wait for the thread to finish, which happens when all
+   * timers (and other asynchronous operations) on the @c io_context have finished.
+   */
+  void join() {
+    finish(join_request);
+  }
+
+  /**
+   * Stop the @c io_context and join the thread. Handlers that have not run are not
+   * invoked, so timers should normally be cancelled (or @c join used) instead.
+   */
+  void stop() {
+    finish(stop_request);
+  }
+
+  /**
+   * Return @c true if the thread has been started and not yet joined.
+   */
+  bool is_running() const noexcept {
+    return m_thr.joinable();
+  }
+};
+
+} // end namespace
+
+#endif
+
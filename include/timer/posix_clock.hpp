@@ -0,0 +1,66 @@
+/** @file
+ *
+ * @brief Mapping of @c std::chrono clock types to POSIX clock ids, for the facilities 
+ * that call POSIX clock functions directly (e.g. @c clock_nanosleep, @c timerfd).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef POSIX_CLOCK_HPP_INCLUDED
+#define POSIX_CLOCK_HPP_INCLUDED
+
+#include <chrono>
+
+#ifdef __linux__
+#include <time.h> // clockid_t, timespec
+#endif
+
+namespace chops {
+
+namespace detail {
+
+// maps a clock type to its POSIX clock, available is false for clocks without one, 
+// and timerfd is false for clocks that timerfd_create does not support
+template <typename Clock>
+struct posix_clock {
+  static constexpr bool available = false;
+  static constexpr bool timerfd = false;
+};
+
+#ifdef __linux__
+template <>
+struct posix_clock<std::chrono::steady_clock> {
+  static constexpr bool available = true;
+  static constexpr bool timerfd = true;
+  static constexpr clockid_t id = CLOCK_MONOTONIC;
+};
+
+template <>
+struct posix_clock<std::chrono::system_clock> {
+  static constexpr bool available = true;
+  static constexpr bool timerfd = true;
+  static constexpr clockid_t id = CLOCK_REALTIME;
+};
+
+template <typename Rep, typename Period>
+timespec to_timespec(const std::chrono::duration<Rep, Period>& dur) noexcept {
+  auto ns { std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count() };
+  timespec ts { };
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000);
+  return ts;
+}
+#endif
+
+} // end detail namespace
+
+} // end namespace
+
+#endif
+
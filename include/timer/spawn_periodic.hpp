@@ -0,0 +1,248 @@
+/** @file
+ *
+ * @brief Self-owning, fire-and-forget periodic timers allocated from a pool.
+ *
+ * A @c periodic_timer must be kept alive by the application until all of its handlers
+ * have run, which typically results in a heap allocated timer held by a
+ * @c std::shared_ptr. @c spawn_periodic instead creates a timepoint timer in a slot of
+ * a pool, and the timer owns itself: the slot is returned to the pool when the
+ * application function object returns @c false (or an empty delay), or when the timer
+ * is cancelled (after the "operation aborted" notification).
+ *
+ * Pool slots are allocated in chunks and reused, so spawning a timer does not allocate
+ * once the pool has grown to the number of concurrently running timers. There is one
+ * pool per clock type, shared by all executors, and the pool is never deallocated.
+ *
+ * @c spawn_periodic returns a small handle which can be used to cancel the timer. The
+ * handle does not keep the timer alive, and a cancel through a handle whose timer has
+ * already finished has no effect, even if the slot has since been reused.
+ *
+ * @code
+ *   chops::spawn_periodic(ioc.get_executor(), 100ms,
+ *     [] (std::error_code err, std::chrono::steady_clock::duration elap) {
+ *       // ...
+ *       return !err;
+ *     }
+ *   );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef SPAWN_PERIODIC_HPP_INCLUDED
+#define SPAWN_PERIODIC_HPP_INCLUDED
+
+#include "asio/any_io_executor.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <new> // placement new
+#include <system_error>
+#include <thread> // std::this_thread
+#include <type_traits> // std::decay_t
+#include <utility> // std::move, std::forward, std::declval
+#include <vector>
+
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+namespace detail {
+
+template <typename Clock>
+class periodic_timer_pool {
+public:
+
+  using timer_type = periodic_timer<Clock>;
+
+  struct slot {
+    alignas(timer_type) unsigned char m_storage[sizeof(timer_type)];
+    std::uint32_t m_gen { 0u };
+    bool m_in_use { false };
+    std::uint32_t m_pins { 0u }; // cancel calls in progress, the slot isn't released meanwhile
+    slot* m_next_free { nullptr };
+
+    timer_type& timer() noexcept {
+      return *std::launder(reinterpret_cast<timer_type*>(m_storage));
+    }
+  };
+
+private:
+
+  static constexpr std::size_t chunk_size = 64u;
+
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<slot[]>> m_chunks;
+  slot* m_free { nullptr };
+
+public:
+
+  // never destroyed, so that timers still running at program exit don't outlive
+  // their io_context in a static destructor
+  static periodic_timer_pool& instance() {
+    static periodic_timer_pool* pool { new periodic_timer_pool };
+    return *pool;
+  }
+
+  slot* acquire(const asio::any_io_executor& ex, std::uint32_t& gen) {
+    std::lock_guard<std::mutex> lk { m_mutex };
+    if (m_free == nullptr) {
+      m_chunks.push_back(std::make_unique<slot[]>(chunk_size));
+      slot* chunk { m_chunks.back().get() };
+      for (std::size_t i = 0u; i < chunk_size; ++i) {
+        chunk[i].m_next_free = m_free;
+        m_free = &chunk[i];
+      }
+    }
+    slot* s { m_free };
+    m_free = s->m_next_free;
+    ::new (static_cast<void*>(s->m_storage)) timer_type(ex);
+    s->m_in_use = true;
+    gen = s->m_gen;
+    return s;
+  }
+
+  void release(slot* s) {
+    // the finishing handler may still be returning on another thread
+    while (s->timer().is_running()) {
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lk { m_mutex };
+    while (s->m_pins != 0u) {
+      lk.unlock();
+      std::this_thread::yield();
+      lk.lock();
+    }
+    s->timer().~timer_type();
+    s->m_in_use = false;
+    ++s->m_gen;
+    s->m_next_free = m_free;
+    m_free = s;
+  }
+
+  // the pool lock isn't held while calling into the timer, only a pin that keeps the 
+  // slot from being released, so that a callback running meanwhile can spawn or cancel 
+  // timers
+  bool cancel(slot* s, std::uint32_t gen) {
+    {
+      std::lock_guard<std::mutex> lk { m_mutex };
+      if (!s->m_in_use || s->m_gen != gen) {
+        return false;
+      }
+      ++s->m_pins;
+    }
+    s->timer().cancel();
+    std::lock_guard<std::mutex> lk { m_mutex };
+    --s->m_pins;
+    return true;
+  }
+
+  std::size_t capacity() {
+    std::lock_guard<std::mutex> lk { m_mutex };
+    return m_chunks.size() * chunk_size;
+  }
+};
+
+// invokes the application function object, and returns the slot to the pool once
+// the timer is finished
+template <typename Clock, typename F>
+class self_owning_callback {
+private:
+  using pool_type = periodic_timer_pool<Clock>;
+
+  typename pool_type::slot* m_slot;
+  asio::any_io_executor     m_ex;
+  F                         m_func;
+
+public:
+  self_owning_callback(typename pool_type::slot* s, const asio::any_io_executor& ex, F&& func) :
+    m_slot(s), m_ex(ex), m_func(std::move(func)) { }
+
+  // the return value (bool, or the delay to the next invocation) is passed through,
+  // with @c false or an empty delay finishing the timer
+  template <typename... Args>
+  auto operator()(const std::error_code& err, Args... args) ->
+        decltype(std::declval<F&>()(err, args...)) {
+    auto more { m_func(err, args...) };
+    if (!more || err == asio::error::operation_aborted) {
+      asio::post(m_ex, [s = m_slot] { pool_type::instance().release(s); } );
+      return decltype(more) { };
+    }
+    return more;
+  }
+};
+
+} // end detail namespace
+
+/**
+ * Handle to a timer created by @c spawn_periodic. The handle does not own the timer.
+ */
+template <typename Clock = std::chrono::steady_clock>
+class spawned_timer {
+private:
+  using pool_type = detail::periodic_timer_pool<Clock>;
+
+  typename pool_type::slot* m_slot;
+  std::uint32_t             m_gen;
+
+public:
+  spawned_timer(typename pool_type::slot* s, std::uint32_t gen) noexcept :
+    m_slot(s), m_gen(gen) { }
+
+  /**
+   * Cancel the timer, which results in the "operation aborted" notification and the
+   * timer returning its slot to the pool. Can be called from any thread.
+   *
+   * @return @c false if the timer had already finished.
+   */
+  bool cancel() const {
+    return pool_type::instance().cancel(m_slot, m_gen);
+  }
+};
+
+/**
+ * Create a self-owning timepoint timer from the pool for the clock type, and start it.
+ *
+ * @param ex Executor for asynchronous processing.
+ *
+ * @param dur Interval to be used between callback invocations.
+ *
+ * @param func Function object to be invoked, with any of the signatures accepted by
+ * @c periodic_timer.
+ *
+ * @return Handle that can be used to cancel the timer.
+ */
+template <typename Clock = std::chrono::steady_clock, typename F>
+spawned_timer<Clock> spawn_periodic(const asio::any_io_executor& ex,
+                                    const typename Clock::duration& dur, F&& func) {
+  using pool_type = detail::periodic_timer_pool<Clock>;
+  std::uint32_t gen { };
+  auto* s { pool_type::instance().acquire(ex, gen) };
+  s->timer().start_timepoint_timer(dur,
+      detail::self_owning_callback<Clock, std::decay_t<F>>(s, ex, std::decay_t<F>(std::forward<F>(func))));
+  return spawned_timer<Clock>(s, gen);
+}
+
+/**
+ * Return the number of slots allocated in the pool for the clock type.
+ */
+template <typename Clock = std::chrono::steady_clock>
+std::size_t spawn_pool_capacity() {
+  return detail::periodic_timer_pool<Clock>::instance().capacity();
+}
+
+} // end namespace
+
+#endif
+
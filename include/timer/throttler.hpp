@@ -0,0 +1,177 @@
+/** @file
+ *
+ * @brief Limit a stream of events to at most one function object invocation per interval,
+ * using a single @c periodic_timer.
+ *
+ * Where a @c debouncer waits for a burst to end, a @c throttler delivers events during
+ * the burst, but no more often than once per interval (e.g. progress updates, or a
+ * metrics flush triggered by incoming data). Each event is recorded with atomic
+ * operations only; the timer is started by the first event after an idle interval, runs
+ * as a timepoint timer while events keep arriving, and finishes after an interval without
+ * events. A burst costs a constant number of timer operations per interval, regardless
+ * of its size.
+ *
+ * With @c throttle_edge::leading the first event of a burst is delivered immediately (on
+ * the @c io_context), and events arriving during each following interval are delivered
+ * together at its end. With @c throttle_edge::trailing the first delivery is also at the
+ * end of the first interval, so every delivery covers a full interval of events.
+ *
+ * @code
+ *   chops::throttler<> progress { ioc, 100ms, chops::throttle_edge::leading,
+ *     [] (std::size_t events) {
+ *       // redraw the progress bar once for events updates
+ *     }
+ *   };
+ *   // for each completed item, on any thread
+ *   progress.notify();
+ * @endcode
+ *
+ * The function object signatures, its storage and the threading rules are the same as
+ * for @c debouncer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef THROTTLER_HPP_INCLUDED
+#define THROTTLER_HPP_INCLUDED
+
+#include "asio/io_context.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <system_error>
+#include <type_traits> // std::is_invocable_v
+#include <utility> // std::forward
+
+#include "timer/inline_function.hpp"
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+/**
+ * Whether a @c throttler delivers the first event of a burst immediately (@c leading),
+ * or at the end of the first interval (@c trailing).
+ */
+enum class throttle_edge { leading, trailing };
+
+template <typename Clock = std::chrono::steady_clock, std::size_t Capacity = 64u>
+class throttler {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+private:
+  periodic_timer<Clock> m_timer;
+  inline_function<void (std::size_t), Capacity> m_func;
+  duration m_interval;
+  throttle_edge m_edge;
+  std::atomic<std::size_t> m_events;
+  std::size_t m_delivered; // only accessed by the timer callback
+  std::atomic<bool> m_pending;
+
+private:
+  // deliver the events recorded since the last delivery, if any
+  bool deliver() {
+    std::size_t events { m_events.load(std::memory_order_acquire) };
+    if (events == m_delivered) {
+      return false;
+    }
+    m_func(events - m_delivered);
+    m_delivered = events;
+    return true;
+  }
+
+  // one invocation per interval, even for timepoints missed by a stalled thread
+  bool expired(const std::error_code& err) {
+    if (err) {
+      m_pending.store(false, std::memory_order_release);
+      return false; // cancelled
+    }
+    if (deliver()) {
+      return true;
+    }
+    // an idle interval, an event from here on starts the timer again unless this
+    // callback keeps it
+    m_pending.store(false, std::memory_order_release);
+    if (m_events.load(std::memory_order_acquire) == m_delivered ||
+        m_pending.exchange(true, std::memory_order_acq_rel)) {
+      return false;
+    }
+    deliver();
+    return true;
+  }
+
+public:
+
+  /**
+   * Construct a @c throttler.
+   *
+   * @param ioc @c io_context for asynchronous processing.
+   *
+   * @param interval Minimum time between invocations of the function object.
+   *
+   * @param edge Whether the first event of a burst is delivered immediately.
+   *
+   * @param func Function object to be invoked with the events of each interval.
+   */
+  template <typename F>
+  throttler(asio::io_context& ioc, const duration& interval, throttle_edge edge, F&& func) :
+      m_timer(ioc), m_func(), m_interval(interval), m_edge(edge), m_events(0u),
+      m_delivered(0u), m_pending(false) {
+    if constexpr (std::is_invocable_v<F&, std::size_t>) {
+      m_func.emplace(std::forward<F>(func));
+    }
+    else {
+      m_func.emplace([f = std::forward<F>(func)] (std::size_t) mutable { f(); });
+    }
+  }
+
+  throttler(const throttler&) = delete;
+  throttler& operator=(const throttler&) = delete;
+
+  /**
+   * Record an event. Only the first event after an idle interval performs a timer
+   * operation. Can be called from any thread.
+   */
+  void notify() {
+    m_events.fetch_add(1u, std::memory_order_acq_rel);
+    if (m_pending.load(std::memory_order_acquire) ||
+        m_pending.exchange(true, std::memory_order_acq_rel)) {
+      return; // the running timer picks the event up
+    }
+    time_point now_time { Clock::now() };
+    m_timer.start_timepoint_timer(m_interval,
+      (m_edge == throttle_edge::leading ? now_time : now_time + m_interval),
+      [this] (std::error_code err, duration, std::size_t) {
+        return expired(err);
+      }
+    );
+  }
+
+  /**
+   * Stop the timer. Events already recorded are delivered with the next burst.
+   */
+  void cancel() {
+    m_timer.cancel();
+  }
+
+  /**
+   * Return @c true if the timer is running, i.e. events are being delivered.
+   */
+  bool is_pending() const noexcept {
+    return m_pending.load(std::memory_order_acquire);
+  }
+};
+
+} // end namespace
+
+#endif
+
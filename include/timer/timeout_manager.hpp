@@ -0,0 +1,312 @@
+/** @file
+ *
+ * @brief Timeouts for many outstanding asynchronous operations on a single
+ * @c periodic_timer, with the deadlines hashed into a timing wheel.
+ *
+ * Giving each outstanding request its own Asio timer puts every request in the Asio
+ * timer queue, and completing a request costs a timer cancel and a handler completion.
+ * Most requests complete long before their timeout. @c timeout_manager keeps the
+ * registrations in a timing wheel: an array of slots, one per tick, each holding an
+ * intrusive list of the registrations whose deadline falls in that tick (modulo the
+ * number of slots). A single timepoint @c periodic_timer advances the wheel once per
+ * tick, and invokes the timeouts of the expired registrations in that slot as a batch.
+ *
+ * Registering and removing a registration are constant time, with no timer operation
+ * and, once the registration storage has grown to the number of outstanding operations,
+ * no allocation:
+ *
+ * @code
+ *   chops::timeout_manager<> timeouts { ioc, 10ms };
+ *   timeouts.start();
+ *
+ *   asio::cancellation_signal sig;
+ *   auto h = timeouts.add(2s, sig);
+ *   sock.async_read_some(buf, asio::bind_cancellation_slot(sig.slot(),
+ *     [&timeouts, h] (std::error_code err, std::size_t n) {
+ *       timeouts.remove(h); // completed (or timed out, in which case this is a no-op)
+ *       // ...
+ *     }
+ *   ));
+ * @endcode
+ *
+ * A registration either emits a cancellation signal (@c asio::cancellation_type::terminal
+ * by default), or invokes a function object with the signature:
+ * @code
+ *   void ();
+ * @endcode
+ * The function object is stored in the registration (see @c timer/inline_function.hpp),
+ * and must fit in the @c Capacity template parameter. A cancellation signal must outlive
+ * its registration.
+ *
+ * A timeout fires between its deadline and one tick after it. Deadlines further out than
+ * the span of the wheel (the number of slots times the tick) stay in their slot for more
+ * than one revolution, and are only checked once per revolution, so the number of slots
+ * should cover the common timeouts.
+ *
+ * A @c timeout_manager is not internally synchronized: all methods must be called from
+ * the thread running the @c io_context, or before it is run. The timeouts can add and
+ * remove registrations. The application must keep the @c timeout_manager alive until its
+ * timer has finished.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TIMEOUT_MANAGER_HPP_INCLUDED
+#define TIMEOUT_MANAGER_HPP_INCLUDED
+
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <system_error>
+#include <utility> // std::move, std::forward
+#include <vector>
+
+#include "timer/inline_function.hpp"
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+template <typename Clock = std::chrono::steady_clock, std::size_t Capacity = 48u>
+class timeout_manager {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  /**
+   * Identifies a registration for @c remove. A handle stays unique after its
+   * registration has expired or been removed, so a stale handle is harmless.
+   */
+  using handle = std::uint64_t;
+
+  /**
+   * A handle that never identifies a registration.
+   */
+  static constexpr handle null_handle = 0u;
+
+private:
+  using func_type = inline_function<void (), Capacity>;
+
+  static constexpr std::uint32_t npos = ~std::uint32_t(0u);
+
+  struct entry {
+    func_type m_func;
+    time_point m_deadline { };
+    std::uint32_t m_prev { npos };
+    std::uint32_t m_next { npos };
+    std::uint32_t m_gen { 1u }; // never zero, so no handle is the null handle
+    std::uint32_t m_slot { npos }; // npos for an unused entry
+  };
+
+  periodic_timer<Clock> m_timer;
+  duration m_tick;
+  time_point m_epoch;
+  std::uint64_t m_next_tick; // the next wheel tick to be processed
+  std::vector<std::uint32_t> m_slots; // head entry of each slot list
+  std::vector<entry> m_entries;
+  std::uint32_t m_free; // unused entries, linked through m_next
+  std::size_t m_size;
+  std::vector<func_type> m_expired; // reused for each batch
+
+private:
+  std::uint64_t tick_of(const time_point& tp) const {
+    if (tp <= m_epoch) {
+      return 0u;
+    }
+    return static_cast<std::uint64_t>((tp - m_epoch + m_tick - duration(1)) / m_tick); // round up
+  }
+
+  void link(std::uint32_t idx, std::uint32_t slot) noexcept {
+    entry& e { m_entries[idx] };
+    e.m_slot = slot;
+    e.m_prev = npos;
+    e.m_next = m_slots[slot];
+    if (e.m_next != npos) {
+      m_entries[e.m_next].m_prev = idx;
+    }
+    m_slots[slot] = idx;
+  }
+  void unlink(std::uint32_t idx) noexcept {
+    entry& e { m_entries[idx] };
+    if (e.m_prev != npos) {
+      m_entries[e.m_prev].m_next = e.m_next;
+    }
+    else {
+      m_slots[e.m_slot] = e.m_next;
+    }
+    if (e.m_next != npos) {
+      m_entries[e.m_next].m_prev = e.m_prev;
+    }
+  }
+  void release(std::uint32_t idx) noexcept {
+    entry& e { m_entries[idx] };
+    e.m_slot = npos;
+    e.m_gen = (e.m_gen == ~std::uint32_t(0u)) ? 1u : e.m_gen + 1u;
+    e.m_next = m_free;
+    m_free = idx;
+    --m_size;
+  }
+
+  // collect the expired registrations of the slots up to now, then invoke them, so that
+  // the timeouts can add and remove registrations
+  void advance() {
+    time_point now_time { Clock::now() };
+    std::uint64_t cur { static_cast<std::uint64_t>((now_time - m_epoch) / m_tick) };
+    std::uint64_t last { cur };
+    if (cur + 1u - m_next_tick > m_slots.size()) { // behind by more than one revolution
+      last = m_next_tick + m_slots.size() - 1u;
+    }
+    for (std::uint64_t t { m_next_tick }; t <= last; ++t) {
+      std::uint32_t idx { m_slots[t % m_slots.size()] };
+      while (idx != npos) {
+        std::uint32_t next { m_entries[idx].m_next };
+        if (m_entries[idx].m_deadline <= now_time) {
+          unlink(idx);
+          m_expired.push_back(std::move(m_entries[idx].m_func));
+          release(idx);
+        }
+        idx = next;
+      }
+    }
+    m_next_tick = cur + 1u;
+    for (auto& f : m_expired) {
+      f();
+    }
+    m_expired.clear();
+  }
+
+public:
+
+  /**
+   * Construct a @c timeout_manager.
+   *
+   * @param ioc @c io_context for the wheel timer.
+   *
+   * @param tick Interval between wheel advances, which is the precision of the timeouts.
+   *
+   * @param slots Number of slots in the wheel; the span of the wheel is the number of
+   * slots times the tick.
+   */
+  timeout_manager(asio::io_context& ioc, const duration& tick, std::size_t slots = 512u) :
+      m_timer(ioc), m_tick(tick), m_epoch(Clock::now()), m_next_tick(1u),
+      m_slots(slots, npos), m_entries(), m_free(npos), m_size(0u), m_expired() { }
+
+  timeout_manager(const timeout_manager&) = delete;
+  timeout_manager& operator=(const timeout_manager&) = delete;
+
+  /**
+   * Start advancing the wheel.
+   */
+  void start() {
+    m_timer.start_timepoint_timer(m_tick,
+      [this] (std::error_code err, duration, std::size_t) {
+        if (err) {
+          return false;
+        }
+        advance();
+        return true;
+      }
+    );
+  }
+
+  /**
+   * Stop advancing the wheel. The registrations are kept, and expire after @c start.
+   */
+  void stop() {
+    m_timer.cancel();
+  }
+
+  /**
+   * Register a function object to be invoked at a deadline, unless removed before.
+   *
+   * @param deadline Time point of the timeout.
+   *
+   * @param func Function object invoked on timeout.
+   *
+   * @return Handle for @c remove.
+   */
+  template <typename F>
+  handle add_until(const time_point& deadline, F&& func) {
+    std::uint32_t idx { m_free };
+    if (idx != npos) {
+      m_free = m_entries[idx].m_next;
+    }
+    else {
+      idx = static_cast<std::uint32_t>(m_entries.size());
+      m_entries.emplace_back();
+    }
+    entry& e { m_entries[idx] };
+    e.m_func.emplace(std::forward<F>(func));
+    e.m_deadline = deadline;
+    std::uint64_t t { tick_of(deadline) };
+    link(idx, static_cast<std::uint32_t>((t < m_next_tick ? m_next_tick : t) % m_slots.size()));
+    ++m_size;
+    return (static_cast<handle>(e.m_gen) << 32u) | idx;
+  }
+
+  /**
+   * Register a function object to be invoked after a timeout.
+   */
+  template <typename F>
+  handle add(const duration& timeout, F&& func) {
+    return add_until(Clock::now() + timeout, std::forward<F>(func));
+  }
+
+  /**
+   * Register a cancellation signal to be emitted after a timeout, e.g. bound to an
+   * asynchronous operation with @c asio::bind_cancellation_slot.
+   *
+   * @param timeout Time allowed for the operation.
+   *
+   * @param sig Signal, which must outlive the registration.
+   *
+   * @param type Type of cancellation requested.
+   */
+  handle add(const duration& timeout, asio::cancellation_signal& sig,
+             asio::cancellation_type type = asio::cancellation_type::terminal) {
+    return add(timeout, [s = &sig, type] { s->emit(type); });
+  }
+
+  /**
+   * Remove a registration, e.g. when its operation completes. Constant time, with no
+   * timer operation.
+   *
+   * @return @c true if the registration was removed, @c false if it had already expired
+   * or been removed.
+   */
+  bool remove(handle h) noexcept {
+    std::uint32_t idx { static_cast<std::uint32_t>(h) };
+    if (idx >= m_entries.size()) {
+      return false;
+    }
+    entry& e { m_entries[idx] };
+    if (e.m_slot == npos || e.m_gen != static_cast<std::uint32_t>(h >> 32u)) {
+      return false;
+    }
+    unlink(idx);
+    e.m_func.reset();
+    release(idx);
+    return true;
+  }
+
+  /**
+   * Return the number of registrations.
+   */
+  std::size_t size() const noexcept {
+    return m_size;
+  }
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,82 @@
+/** @file
+ *
+ * @brief Error codes reported by the timer classes to application function objects, in
+ * addition to the Asio error codes.
+ *
+ * The error codes are in their own @c std::error_category, and a @c timer_errc value
+ * can be compared directly against the @c std::error_code passed to the callback:
+ * @code
+ *   if (err == chops::timer_errc::clock_jump) {
+ *     // ...
+ *   }
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TIMER_ERROR_HPP_INCLUDED
+#define TIMER_ERROR_HPP_INCLUDED
+
+#include <string>
+#include <system_error>
+#include <type_traits> // std::true_type
+
+namespace chops {
+
+/**
+ * Timer error codes.
+ *
+ * @c clock_jump is reported when the clock of a timer has been stepped (e.g. by NTP or
+ * an administrator), and the timepoint sequence has been re-anchored to the new time.
+ */
+enum class timer_errc {
+  clock_jump = 1
+};
+
+namespace detail {
+
+class timer_category_impl : public std::error_category {
+public:
+  const char* name() const noexcept override {
+    return "chops::timer";
+  }
+  std::string message(int ev) const override {
+    switch (static_cast<timer_errc>(ev)) {
+      case timer_errc::clock_jump:
+        return "clock jump, timer re-anchored";
+    }
+    return "unknown timer error";
+  }
+};
+
+} // end detail namespace
+
+/**
+ * Return the error category of the timer error codes.
+ */
+inline const std::error_category& timer_category() noexcept {
+  static const detail::timer_category_impl category { };
+  return category;
+}
+
+inline std::error_code make_error_code(timer_errc e) noexcept {
+  return std::error_code(static_cast<int>(e), timer_category());
+}
+
+} // end namespace
+
+namespace std {
+
+template <>
+struct is_error_code_enum<chops::timer_errc> : true_type { };
+
+}
+
+#endif
+
@@ -0,0 +1,265 @@
+/** @file
+ *
+ * @brief A Linux periodic timer backed by a kernel periodic @c timerfd, armed once per
+ * start rather than once per tick.
+ *
+ * A @c periodic_timer re-arms its Asio timer on each tick, which goes through the Asio
+ * timer queue and re-programs the reactor's kernel timer. @c timerfd_timer instead arms
+ * a @c timerfd with an interval, so the kernel produces one expiration per period on
+ * its own. Each tick only waits for the descriptor to become readable (through the
+ * @c io_context reactor, which may be epoll or io_uring) and reads the expiration count.
+ *
+ * The expiration count from the kernel maps directly onto the batch callback signature:
+ * @code
+ *   bool (std::error_code, duration, std::size_t);
+ * @endcode
+ * A callback with the two parameter signature is invoked once for each expiration, in
+ * quick succession, as with a @c periodic_timer timepoint timer that has fallen behind.
+ *
+ * The timepoints follow the same grid as @c periodic_timer::start_timepoint_timer, so
+ * the elapsed time passed to the callback has the same meaning.
+ *
+ * Unlike @c periodic_timer, a @c timerfd_timer is not internally synchronized: the
+ * @c start and @c cancel methods must be called from the thread running the
+ * @c io_context (e.g. from within the callback or through @c asio::post), or before
+ * the @c io_context is run.
+ *
+ * As for @c periodic_timer, the application must keep the @c timerfd_timer alive until
+ * its handlers have run.
+ *
+ * Only clocks supported by @c timerfd_create can be used (@c std::chrono::steady_clock,
+ * @c std::chrono::system_clock and @c chops::boottime_clock).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TIMERFD_TIMER_HPP_INCLUDED
+#define TIMERFD_TIMER_HPP_INCLUDED
+
+#ifdef __linux__
+
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <system_error>
+#include <type_traits> // std::is_invocable_v
+#include <utility> // std::move, std::forward
+
+#include <sys/timerfd.h>
+#include <unistd.h> // read
+
+#include "timer/posix_clock.hpp"
+
+namespace chops {
+
+template <typename Clock = std::chrono::steady_clock>
+class timerfd_timer {
+public:
+
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  static_assert(detail::posix_clock<Clock>::timerfd,
+                "timerfd_timer requires a clock supported by timerfd_create");
+
+private:
+  asio::posix::stream_descriptor m_fd;
+  duration m_period;
+  time_point m_last_tp;
+  unsigned m_gen;
+  bool m_cancelled;
+
+private:
+  template <typename F>
+  static constexpr bool is_batch_callback =
+      std::is_invocable_v<F&, const std::error_code&, duration, std::size_t>;
+
+  template <typename F>
+  static bool invoke(F& func, const std::error_code& err, const duration& elap,
+                     std::size_t expirations) {
+    if constexpr (is_batch_callback<F>) {
+      return func(err, elap, expirations);
+    }
+    else {
+      return func(err, elap);
+    }
+  }
+
+  static std::error_code last_error() {
+    return std::error_code(errno, std::system_category());
+  }
+
+  std::error_code arm(const time_point& first, const duration& period) {
+    itimerspec spec { };
+    spec.it_value = detail::to_timespec(first.time_since_epoch());
+    spec.it_interval = detail::to_timespec(period);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+      spec.it_value.tv_nsec = 1; // zero would disarm the timer
+    }
+    if (::timerfd_settime(m_fd.native_handle(), TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+      return last_error();
+    }
+    return std::error_code();
+  }
+  void disarm() noexcept {
+    itimerspec spec { };
+    ::timerfd_settime(m_fd.native_handle(), 0, &spec, nullptr);
+  }
+
+  template <typename F>
+  void wait(unsigned gen, F&& func) {
+    m_fd.async_wait(asio::posix::stream_descriptor::wait_read,
+      [gen, f = std::move(func), this] (const std::error_code& err) mutable {
+        handler_impl(gen, err, std::move(f));
+      }
+    );
+  }
+
+  template <typename F>
+  void handler_impl(unsigned gen, const std::error_code& err, F&& func) {
+    if (gen != m_gen) {
+      invoke(func, asio::error::operation_aborted, Clock::now() - m_last_tp, 0u);
+      return; // handler from a previous start
+    }
+    if (err || m_cancelled) {
+      invoke(func, (err ? err : asio::error::operation_aborted), Clock::now() - m_last_tp, 0u);
+      disarm();
+      return;
+    }
+    std::uint64_t expirations { 0u };
+    if (::read(m_fd.native_handle(), &expirations, sizeof(expirations)) !=
+               static_cast<ssize_t>(sizeof(expirations))) {
+      if (errno == EAGAIN) {
+        wait(gen, std::forward<F>(func)); // spurious wake-up
+        return;
+      }
+      invoke(func, last_error(), Clock::now() - m_last_tp, 0u);
+      disarm();
+      return;
+    }
+    if constexpr (is_batch_callback<F>) {
+      bool more { invoke(func, err, (Clock::now() - m_last_tp), expirations) };
+      if (gen != m_gen) {
+        return; // a start from within the callback owns the timer now
+      }
+      m_last_tp += static_cast<typename duration::rep>(expirations) * m_period;
+      if (!more) {
+        disarm();
+        return;
+      }
+    }
+    else {
+      for (std::uint64_t i = 0u; i < expirations && !m_cancelled; ++i) {
+        bool more { invoke(func, err, (Clock::now() - m_last_tp), 1u) };
+        if (gen != m_gen) {
+          return; // a start from within the callback owns the timer now
+        }
+        m_last_tp += m_period;
+        if (!more) {
+          disarm();
+          return;
+        }
+      }
+    }
+    if (m_cancelled) { // cancelled from within the callback
+      invoke(func, asio::error::operation_aborted, Clock::now() - m_last_tp, 0u);
+      return;
+    }
+    wait(gen, std::forward<F>(func));
+  }
+
+public:
+
+  /**
+   * Construct a @c timerfd_timer, creating the @c timerfd.
+   *
+   * @param ioc @c io_context whose reactor waits on the @c timerfd.
+   *
+   * @throw std::system_error if the @c timerfd cannot be created.
+   */
+  explicit timerfd_timer(asio::io_context& ioc) :
+      m_fd(ioc), m_period(duration::zero()), m_last_tp(), m_gen(0u), m_cancelled(false) {
+    int fd { ::timerfd_create(detail::posix_clock<Clock>::id, TFD_NONBLOCK | TFD_CLOEXEC) };
+    if (fd < 0) {
+      throw std::system_error(last_error(), "timerfd_create");
+    }
+    m_fd.assign(fd);
+  }
+
+  timerfd_timer(const timerfd_timer&) = delete;
+  timerfd_timer& operator=(const timerfd_timer&) = delete;
+
+  /**
+   * Start the timer, first invoking the application function object after one
+   * duration, then on each following timepoint. A running timer is cancelled first,
+   * with "operation aborted" notification.
+   *
+   * @param dur Interval between timepoints, which must be greater than zero.
+   *
+   * @param func Function object to be invoked, with either of the signatures above.
+   *
+   * @return An error if the @c timerfd could not be armed, in which case the function
+   * object is not invoked.
+   */
+  template <typename F>
+  std::error_code start_timepoint_timer(const duration& dur, F&& func) {
+    return start_timepoint_timer(dur, (Clock::now() + dur), std::forward<F>(func));
+  }
+
+  /**
+   * Start the timer, first invoking the application function object at a specified
+   * time point, then on each following timepoint.
+   *
+   * @param dur Interval between timepoints, which must be greater than zero.
+   *
+   * @param when Time point of the first invocation.
+   *
+   * @param func Function object to be invoked.
+   *
+   * @return An error if the @c timerfd could not be armed.
+   */
+  template <typename F>
+  std::error_code start_timepoint_timer(const duration& dur, const time_point& when, F&& func) {
+    if (dur <= duration::zero()) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    m_fd.cancel(); // a pending wait from a previous start gets operation_aborted
+    if (auto err { arm(when, dur) }; err) {
+      return err;
+    }
+    ++m_gen;
+    m_cancelled = false;
+    m_period = dur;
+    m_last_tp = when - dur;
+    wait(m_gen, std::forward<F>(func));
+    return std::error_code();
+  }
+
+  /**
+   * Cancel the timer. The application function object will be called with an
+   * "operation aborted" error code.
+   */
+  void cancel() {
+    m_cancelled = true;
+    disarm();
+    m_fd.cancel();
+  }
+};
+
+} // end namespace
+
+#endif // __linux__
+
+#endif
+
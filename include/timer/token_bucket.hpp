@@ -0,0 +1,162 @@
+/** @file
+ *
+ * @brief A token bucket rate limiter, refilled by a @c periodic_timer, with a lock-free
+ * acquire usable from any thread.
+ *
+ * A token bucket allows bursts of up to its capacity, and a long-run rate equal to its
+ * refill rate. The usual implementation protects the token count with a mutex and
+ * computes the refill from a clock read on each acquire. @c token_bucket instead
+ * publishes refills from a timepoint @c periodic_timer, so that @c try_acquire is a
+ * compare-and-swap on an atomic count, without a clock read or a lock:
+ *
+ * @code
+ *   // bursts of up to 100 requests, 1000 requests per second on average
+ *   chops::token_bucket<> limiter { ioc, 100u, 10u, 10ms };
+ *   limiter.start();
+ *   // on any thread
+ *   if (!limiter.try_acquire()) {
+ *     // reject the request
+ *   }
+ * @endcode
+ *
+ * The refill granularity is the timer period: a shorter period spreads the refills more
+ * evenly, at the cost of more timer wake-ups. Timepoints missed by a stalled
+ * @c io_context thread are refilled together on the next callback, so the long-run rate
+ * is kept.
+ *
+ * The application must keep the @c token_bucket alive until its timer has finished
+ * (e.g. after @c stop, once @c is_running on the timer returns @c false).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TOKEN_BUCKET_HPP_INCLUDED
+#define TOKEN_BUCKET_HPP_INCLUDED
+
+#include "asio/io_context.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <system_error>
+
+#include "timer/periodic_timer.hpp"
+
+namespace chops {
+
+template <typename Clock = std::chrono::steady_clock>
+class token_bucket {
+public:
+
+  using duration = typename Clock::duration;
+
+private:
+  periodic_timer<Clock> m_timer;
+  std::atomic<std::size_t> m_tokens;
+  std::size_t m_capacity;
+  std::size_t m_refill;
+  duration m_period;
+
+private:
+  void refill(std::size_t ticks) noexcept {
+    std::size_t add { ticks * m_refill };
+    std::size_t cur { m_tokens.load(std::memory_order_relaxed) };
+    for (;;) {
+      std::size_t next { (m_capacity - cur < add) ? m_capacity : cur + add };
+      if (next == cur ||
+          m_tokens.compare_exchange_weak(cur, next, std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+public:
+
+  /**
+   * Construct a @c token_bucket, initially full.
+   *
+   * @param ioc @c io_context for the refill timer.
+   *
+   * @param capacity Maximum number of tokens, i.e. the largest burst.
+   *
+   * @param refill Number of tokens added each period.
+   *
+   * @param period Interval between refills.
+   */
+  token_bucket(asio::io_context& ioc, std::size_t capacity, std::size_t refill,
+               const duration& period) :
+      m_timer(ioc), m_tokens(capacity), m_capacity(capacity), m_refill(refill),
+      m_period(period) { }
+
+  token_bucket(const token_bucket&) = delete;
+  token_bucket& operator=(const token_bucket&) = delete;
+
+  /**
+   * Start refilling the bucket.
+   */
+  void start() {
+    m_timer.start_timepoint_timer(m_period,
+      [this] (std::error_code err, duration, std::size_t ticks) {
+        if (err) {
+          return false;
+        }
+        refill(ticks);
+        return true;
+      }
+    );
+  }
+
+  /**
+   * Stop refilling the bucket. Tokens already in the bucket can still be acquired.
+   */
+  void stop() {
+    m_timer.cancel();
+  }
+
+  /**
+   * Take tokens from the bucket if enough are available. Lock-free, and can be called
+   * from any thread.
+   *
+   * @param n Number of tokens to take.
+   *
+   * @return @c true if the tokens were taken, @c false (and no tokens are taken) if
+   * fewer than @c n are available.
+   */
+  bool try_acquire(std::size_t n = 1u) noexcept {
+    std::size_t cur { m_tokens.load(std::memory_order_relaxed) };
+    while (cur >= n) {
+      if (m_tokens.compare_exchange_weak(cur, cur - n, std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Return the number of tokens currently available, which may change immediately
+   * after the call.
+   */
+  std::size_t available() const noexcept {
+    return m_tokens.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return @c true if the refill timer is running.
+   */
+  bool is_running() const noexcept {
+    return m_timer.is_running();
+  }
+};
+
+} // end namespace
+
+#endif
+
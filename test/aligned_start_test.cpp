@@ -0,0 +1,88 @@
+/** @file
+ *
+ * @brief Test scenarios for @c aligned_time_point.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <system_error>
+
+#include "asio/io_context.hpp"
+
+#include "timer/aligned_start.hpp"
+#include "timer/periodic_timer.hpp"
+
+using namespace std::chrono_literals;
+
+// distance of a wall clock time from the nearest boundary of the period
+template <typename Dur>
+std::chrono::system_clock::duration boundary_distance(std::chrono::system_clock::time_point tp,
+                                                      Dur period, Dur offset = Dur::zero()) {
+  auto phase = (tp.time_since_epoch() - offset) % period;
+  return phase < (period - phase) ? phase : (period - phase);
+}
+
+SCENARIO ( "Aligned start time points are on wall clock boundaries", "[aligned_start]" ) {
+
+  GIVEN ( "The system clock as the timer clock") {
+    auto now = std::chrono::system_clock::now();
+    auto tp = chops::aligned_time_point<std::chrono::system_clock>(100ms);
+    THEN ( "the time point is the next multiple of the period since the epoch" ) {
+      REQUIRE (tp.time_since_epoch() % 100ms == 0ms);
+      REQUIRE (tp > now);
+      REQUIRE (tp <= now + 100ms + 5ms);
+    }
+    AND_THEN ( "an offset shifts the boundary" ) {
+      auto tp_off = chops::aligned_time_point<std::chrono::system_clock>(1min, 15s);
+      REQUIRE ((tp_off.time_since_epoch() - 15s) % 1min == 0ms);
+      REQUIRE (tp_off > now);
+      REQUIRE (tp_off <= now + 1min + 5ms);
+    }
+  }
+
+  GIVEN ( "The steady clock as the timer clock") {
+    auto now = std::chrono::steady_clock::now();
+    auto tp = chops::aligned_time_point(100ms);
+    THEN ( "the time point is at most one period in the future" ) {
+      REQUIRE (tp > now);
+      REQUIRE (tp <= now + 100ms + 5ms);
+    }
+    AND_THEN ( "it corresponds to a wall clock boundary" ) {
+      auto wall = std::chrono::system_clock::now() + (tp - std::chrono::steady_clock::now());
+      REQUIRE (boundary_distance(wall, std::chrono::system_clock::duration(100ms)) < 2ms);
+    }
+  }
+
+  GIVEN ( "A timepoint timer started on an aligned time point") {
+    asio::io_context ioc;
+    chops::periodic_timer<> timer { ioc };
+    int count = 0;
+    std::chrono::system_clock::duration max_dist { };
+    timer.start_timepoint_timer(50ms, chops::aligned_time_point(50ms),
+      [&count, &max_dist] (std::error_code err, std::chrono::steady_clock::duration) {
+        REQUIRE_FALSE (err);
+        auto dist = boundary_distance(std::chrono::system_clock::now(),
+                                      std::chrono::system_clock::duration(50ms));
+        max_dist = dist > max_dist ? dist : max_dist;
+        return ++count < 5;
+      }
+    );
+    ioc.run();
+    THEN ( "each callback is invoked close to a wall clock boundary" ) {
+      REQUIRE (count == 5);
+      REQUIRE (max_dist < 15ms);
+    }
+  }
+}
+
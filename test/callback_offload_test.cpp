@@ -0,0 +1,161 @@
+/** @file
+ *
+ * @brief Test scenarios for the @c offload callback adaptor.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <system_error>
+#include <set>
+#include <vector>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/thread_pool.hpp"
+
+#include "timer/periodic_timer.hpp"
+#include "timer/callback_offload.hpp"
+
+using namespace std::chrono_literals;
+
+using wk_guard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+struct offload_counts {
+  std::atomic<int> calls { 0 };
+  std::atomic<int> running { 0 };
+  std::atomic<int> max_running { 0 };
+  std::atomic<int> aborted { 0 };
+};
+
+// each invocation takes 3 timer periods
+void offload_util (chops::overlap_policy policy, int max_calls, offload_counts& counts) {
+
+  asio::io_context ioc;
+  asio::thread_pool pool { 4 };
+  chops::periodic_timer<> timer {ioc};
+  wk_guard wg { asio::make_work_guard(ioc) };
+
+  std::thread thr([&ioc] () { ioc.run(); } );
+
+  timer.start_timepoint_timer(20ms, chops::offload(pool.get_executor(),
+      [&counts, max_calls] (std::error_code err, std::chrono::steady_clock::duration) {
+        if (err) {
+          ++counts.aborted;
+          return false;
+        }
+        int r = ++counts.running;
+        int m = counts.max_running.load();
+        while (r > m && !counts.max_running.compare_exchange_weak(m, r)) { }
+        std::this_thread::sleep_for(60ms);
+        --counts.running;
+        return ++counts.calls < max_calls;
+      }, policy)
+  );
+
+  std::this_thread::sleep_for(500ms);
+  asio::post(ioc, [&timer] { timer.cancel(); } );
+  wg.reset();
+  thr.join();
+  pool.join();
+}
+
+SCENARIO ( "Periodic timer callbacks can be offloaded to a thread pool", "[offload]" ) {
+
+  GIVEN ( "A 20 ms timer with a callback that takes 60 ms") {
+    offload_counts counts;
+
+    WHEN ( "The overlap policy is skip" ) {
+      offload_util(chops::overlap_policy::skip, 1000, counts);
+      THEN ( "invocations do not overlap and expiries are skipped") {
+        REQUIRE (counts.max_running == 1);
+        REQUIRE (counts.calls > 3);
+        REQUIRE (counts.calls < 12);
+        REQUIRE (counts.aborted == 1);
+      }
+    }
+    WHEN ( "The overlap policy is queue" ) {
+      offload_util(chops::overlap_policy::queue, 1000, counts);
+      THEN ( "invocations do not overlap and run once per expiry") {
+        REQUIRE (counts.max_running == 1);
+        REQUIRE (counts.calls > 20);
+        REQUIRE (counts.aborted == 1);
+      }
+    }
+    WHEN ( "The overlap policy is concurrent" ) {
+      offload_util(chops::overlap_policy::concurrent, 1000, counts);
+      THEN ( "invocations overlap") {
+        REQUIRE (counts.max_running > 1);
+        REQUIRE (counts.calls > 20);
+        REQUIRE (counts.aborted == 1);
+      }
+    }
+    WHEN ( "The callback returns false" ) {
+      offload_util(chops::overlap_policy::skip, 2, counts);
+      THEN ( "the timer stops without further invocations") {
+        REQUIRE (counts.calls == 2);
+        REQUIRE (counts.aborted == 0);
+      }
+    }
+  } // end given
+
+  GIVEN ( "A 10 ms timer with a queued callback that takes 30 ms") {
+    asio::io_context ioc;
+    asio::thread_pool pool { 4 };
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+    std::vector<std::chrono::steady_clock::duration> elaps;
+    std::atomic<int> aborted { 0 };
+
+    auto cb = chops::offload(pool.get_executor(),
+        [&elaps, &aborted] (std::error_code err, std::chrono::steady_clock::duration elap) {
+          if (err) {
+            ++aborted;
+            return false;
+          }
+          elaps.push_back(elap);
+          std::this_thread::sleep_for(30ms);
+          return true;
+        }, chops::overlap_policy::queue);
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    asio::post(ioc, [&timer, cb] { timer.start_timepoint_timer(10ms, cb); } );
+    std::this_thread::sleep_for(100ms);
+    asio::post(ioc, [&timer] { timer.cancel(); } );
+    while (aborted == 0) { // the queued invocations run first
+      std::this_thread::sleep_for(10ms);
+    }
+    std::size_t first_run { elaps.size() };
+
+    WHEN ( "The same adaptor is used to start the timer again after the cancel" ) {
+      asio::post(ioc, [&timer, cb] { timer.start_timepoint_timer(10ms, cb); } );
+      std::this_thread::sleep_for(50ms);
+      asio::post(ioc, [&timer] { timer.cancel(); } );
+      wg.reset();
+      thr.join();
+      pool.join();
+
+      THEN ( "each invocation receives the elapsed time of its own expiry, and the second "
+             "run is invoked as well") {
+        REQUIRE (first_run > 5u);
+        REQUIRE (std::set<std::chrono::steady_clock::duration>(elaps.cbegin(),
+                   elaps.cbegin() + first_run).size() == first_run);
+        REQUIRE (elaps.size() > first_run);
+        REQUIRE (aborted == 2);
+      }
+    }
+  } // end given
+}
+
@@ -0,0 +1,62 @@
+/** @file
+ *
+ * @brief Test scenarios for @c clock_jump_notifier.
+ *
+ * The system clock can't be stepped by an unprivileged test, so only starting and 
+ * cancelling the notifier is tested.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <system_error>
+
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+
+#include "timer/clock_jump_notifier.hpp"
+
+using namespace std::chrono_literals;
+
+SCENARIO ( "A clock jump notifier can be started and cancelled", "[clock_jump_notifier]" ) {
+
+  GIVEN ( "A started notifier") {
+    asio::io_context ioc;
+    chops::clock_jump_notifier notifier { ioc };
+    int jumps = 0;
+    int aborted = 0;
+    auto func = [&jumps, &aborted] (std::error_code err) {
+      aborted += (err == asio::error::operation_aborted);
+      jumps += !err;
+      return !err;
+    };
+    REQUIRE_FALSE (notifier.start(func));
+
+    WHEN ( "It is cancelled" ) {
+      asio::post(ioc, [&notifier] { notifier.cancel(); } );
+      ioc.run();
+      THEN ( "the function object is notified once") {
+        REQUIRE (aborted == 1);
+        REQUIRE (jumps == 0);
+      }
+    }
+    WHEN ( "It is restarted" ) {
+      REQUIRE_FALSE (notifier.start(func));
+      asio::post(ioc, [&notifier] { notifier.cancel(); } );
+      ioc.run();
+      THEN ( "both function objects are notified") {
+        REQUIRE (aborted == 2);
+        REQUIRE (jumps == 0);
+      }
+    }
+  } // end given
+}
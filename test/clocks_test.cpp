@@ -0,0 +1,146 @@
+/** @file
+ *
+ * @brief Test scenarios for @c boottime_clock, @c tai_clock and @c capped_wait_traits.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <system_error>
+
+#include "asio/io_context.hpp"
+
+#include "timer/clocks.hpp"
+#include "timer/periodic_loop.hpp"
+#include "timer/timerfd_timer.hpp"
+
+using namespace std::chrono_literals;
+
+constexpr int Expected = 9;
+
+template <typename Clock, typename Timer>
+void periodic_util () {
+  asio::io_context ioc;
+  Timer timer { ioc };
+  int count = 0;
+  auto start = Clock::now();
+
+  timer.start_timepoint_timer(10ms,
+    [&count] (std::error_code err, typename Clock::duration) {
+      REQUIRE_FALSE (err);
+      return ++count < Expected;
+    }
+  );
+  ioc.run();
+  auto elap = Clock::now() - start;
+
+  REQUIRE (count == Expected);
+  REQUIRE (elap >= Expected*10ms);
+  REQUIRE (elap < (Expected+5)*10ms);
+}
+
+template <typename Clock>
+void loop_util () {
+  chops::periodic_loop<Clock> loop;
+  int count = 0;
+  auto start = Clock::now();
+  loop.run(10ms, [&count] (std::error_code err, typename Clock::duration) {
+      REQUIRE_FALSE (err);
+      return ++count < Expected;
+    }
+  );
+  auto elap = Clock::now() - start;
+
+  REQUIRE (count == Expected);
+  REQUIRE (elap >= Expected*10ms);
+  REQUIRE (elap < (Expected+5)*10ms);
+}
+
+SCENARIO ( "The Linux boottime and TAI clocks", "[clocks]" ) {
+
+  GIVEN ( "The boottime clock") {
+    auto t1 = chops::boottime_clock::now();
+    auto t2 = chops::boottime_clock::now();
+    THEN ( "it is monotonic and at least as far along as the steady clock" ) {
+      REQUIRE (t2 >= t1);
+      REQUIRE (t1.time_since_epoch() + 1ms >=
+               std::chrono::steady_clock::now().time_since_epoch());
+    }
+  }
+  GIVEN ( "The TAI clock") {
+    auto offset = chops::tai_clock::now().time_since_epoch() -
+                  std::chrono::system_clock::now().time_since_epoch();
+    THEN ( "it is ahead of the system clock by the TAI offset, or equal when none is set" ) {
+      REQUIRE (offset > -1s);
+      REQUIRE (offset < 60s);
+    }
+  }
+}
+
+SCENARIO ( "Capped wait traits limit each reactor wait", "[clocks]" ) {
+
+  using traits = chops::capped_wait_traits<chops::boottime_clock, 50>;
+
+  GIVEN ( "Durations shorter and longer than the maximum wait") {
+    THEN ( "only the longer duration is capped" ) {
+      REQUIRE (traits::to_wait_duration(chops::boottime_clock::duration(20ms)) == 20ms);
+      REQUIRE (traits::to_wait_duration(chops::boottime_clock::duration(10s)) == 50ms);
+      REQUIRE (traits::to_wait_duration(chops::boottime_clock::now() + 1h) == 50ms);
+    }
+  }
+  GIVEN ( "A timer with a period several times the maximum wait") {
+    asio::io_context ioc;
+    chops::periodic_timer<chops::boottime_clock, void, 0u, traits> timer { ioc };
+    int count = 0;
+    auto start = chops::boottime_clock::now();
+    timer.start_timepoint_timer(120ms,
+      [&count] (std::error_code err, chops::boottime_clock::duration) {
+        REQUIRE_FALSE (err);
+        return ++count < 2;
+      }
+    );
+    ioc.run();
+    auto elap = chops::boottime_clock::now() - start;
+    THEN ( "the timepoints are still reached on time" ) {
+      REQUIRE (count == 2);
+      REQUIRE (elap >= 240ms);
+      REQUIRE (elap < 290ms);
+    }
+  }
+}
+
+SCENARIO ( "Timers and loops on the boottime and TAI clocks", "[clocks]" ) {
+
+  GIVEN ( "Periodic timers") {
+    periodic_util<chops::boottime_clock, chops::boottime_periodic_timer>();
+    periodic_util<chops::tai_clock, chops::tai_periodic_timer>();
+  }
+  GIVEN ( "Periodic loops, sleeping on the corresponding POSIX clock") {
+    loop_util<chops::boottime_clock>();
+    loop_util<chops::tai_clock>();
+  }
+  GIVEN ( "A timerfd timer on the boottime clock") {
+    asio::io_context ioc;
+    chops::timerfd_timer<chops::boottime_clock> timer { ioc };
+    int count = 0;
+    REQUIRE_FALSE (timer.start_timepoint_timer(10ms,
+      [&count] (std::error_code err, chops::boottime_clock::duration) {
+        REQUIRE_FALSE (err);
+        return ++count < Expected;
+      })
+    );
+    ioc.run();
+    REQUIRE (count == Expected);
+  }
+}
+
@@ -0,0 +1,101 @@
+/** @file
+ *
+ * @brief Test scenarios for @c deadline_timer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <system_error>
+
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+
+#include "timer/deadline_timer.hpp"
+
+using namespace std::chrono_literals;
+using dur_type = std::chrono::steady_clock::duration;
+
+SCENARIO ( "A deadline timer expires only when it is not kicked", "[deadline_timer]" ) {
+
+  asio::io_context ioc;
+  chops::deadline_timer<> watchdog { ioc };
+  int expiries = 0;
+  dur_type idle { };
+
+  GIVEN ( "A 20 ms watchdog kicked every 2 ms from another thread for 100 ms") {
+    std::atomic<bool> kicking { true };
+    std::chrono::steady_clock::time_point last_kick { };
+    watchdog.start(20ms, [&expiries, &idle] (std::error_code err, dur_type elap) {
+        REQUIRE_FALSE (err);
+        ++expiries;
+        idle = elap;
+        return false;
+      }
+    );
+    std::thread kicker([&watchdog, &kicking, &last_kick] {
+        auto end = std::chrono::steady_clock::now() + 100ms;
+        while (std::chrono::steady_clock::now() < end) {
+          watchdog.kick();
+          std::this_thread::sleep_for(2ms);
+        }
+        last_kick = std::chrono::steady_clock::now();
+        watchdog.kick();
+        kicking = false;
+      }
+    );
+    ioc.run();
+    auto expired = std::chrono::steady_clock::now();
+    kicker.join();
+
+    THEN ( "it expires once, one timeout after the kicks stop" ) {
+      REQUIRE_FALSE (kicking);
+      REQUIRE (expiries == 1);
+      REQUIRE (idle >= 20ms);
+      REQUIRE (idle < 30ms);
+      REQUIRE (expired - last_kick >= 20ms);
+      REQUIRE (expired - last_kick < 30ms);
+    }
+  }
+
+  GIVEN ( "A watchdog that continues after each expiry") {
+    auto start = std::chrono::steady_clock::now();
+    watchdog.start(10ms, [&expiries] (std::error_code err, dur_type) {
+        REQUIRE_FALSE (err);
+        return ++expiries < 3;
+      }
+    );
+    ioc.run();
+    THEN ( "each expiry is one timeout after the previous one" ) {
+      REQUIRE (expiries == 3);
+      REQUIRE (std::chrono::steady_clock::now() - start >= 30ms);
+    }
+  }
+
+  GIVEN ( "A watchdog cancelled before its deadline") {
+    std::error_code result { };
+    watchdog.start(1s, [&result] (std::error_code err, dur_type) {
+        result = err;
+        return false;
+      }
+    );
+    asio::post(ioc, [&watchdog] { watchdog.cancel(); });
+    ioc.run();
+    THEN ( "the function object is notified with operation aborted" ) {
+      REQUIRE (result == asio::error::operation_aborted);
+    }
+  }
+}
+
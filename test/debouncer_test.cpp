@@ -0,0 +1,87 @@
+/** @file
+ *
+ * @brief Test scenarios for @c debouncer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include "timer/debouncer.hpp"
+
+using namespace std::chrono_literals;
+
+SCENARIO ( "A debouncer coalesces a burst of events", "[debouncer]" ) {
+
+  asio::io_context ioc;
+  auto wg { asio::make_work_guard(ioc) };
+  std::thread thr([&ioc] () { ioc.run(); } );
+
+  std::vector<std::size_t> deliveries;
+  std::vector<std::chrono::steady_clock::time_point> times;
+  chops::debouncer<> deb { ioc, 20ms, [&deliveries, &times] (std::size_t events) {
+      deliveries.push_back(events);
+      times.push_back(std::chrono::steady_clock::now());
+    }
+  };
+
+  GIVEN ( "Two bursts of events separated by more than the quiet period") {
+    std::chrono::steady_clock::time_point burst_end[2];
+    for (int b = 0; b < 2; ++b) {
+      auto end = std::chrono::steady_clock::now() + 50ms;
+      int n = 0;
+      while (std::chrono::steady_clock::now() < end) {
+        deb.notify();
+        if (++n % 1000 == 0) {
+          std::this_thread::sleep_for(1ms);
+        }
+      }
+      burst_end[b] = std::chrono::steady_clock::now();
+      std::this_thread::sleep_for(60ms);
+    }
+    wg.reset();
+    thr.join();
+
+    THEN ( "the function object is invoked once per burst, a quiet period after it" ) {
+      REQUIRE (deliveries.size() == 2u);
+      REQUIRE (deliveries[0] > 1000u);
+      REQUIRE (deliveries[1] > 1000u);
+      REQUIRE (times[0] - burst_end[0] >= 17ms);
+      REQUIRE (times[0] - burst_end[0] < 40ms);
+      REQUIRE (times[1] - burst_end[1] >= 17ms);
+      REQUIRE_FALSE (deb.is_pending());
+    }
+  }
+
+  GIVEN ( "A burst that is cancelled") {
+    deb.notify();
+    deb.notify();
+    deb.cancel();
+    std::this_thread::sleep_for(40ms);
+    deb.notify();
+    std::this_thread::sleep_for(40ms);
+    wg.reset();
+    thr.join();
+
+    THEN ( "the cancelled events are delivered with the next burst" ) {
+      REQUIRE (deliveries.size() == 1u);
+      REQUIRE (deliveries[0] == 3u);
+    }
+  }
+}
+
@@ -0,0 +1,100 @@
+/** @file
+ *
+ * @brief Test scenarios for @c idle_timeout_set.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "asio/io_context.hpp"
+
+#include "timer/idle_timeout_set.hpp"
+#include "timer/periodic_timer.hpp"
+
+using namespace std::chrono_literals;
+
+struct conn : chops::idle_timeout_hook<> {
+  explicit conn(int i) : id(i) { }
+  int id;
+  std::chrono::steady_clock::time_point closed { };
+};
+
+SCENARIO ( "An idle timeout set expires the entries without activity", "[idle_timeout_set]" ) {
+
+  asio::io_context ioc;
+  std::vector<conn> conns;
+  for (int i = 0; i < 6; ++i) {
+    conns.emplace_back(i);
+  }
+  std::vector<int> expired;
+  chops::idle_timeout_set<conn> idle { ioc, 30ms, 5ms, [&expired] (conn& c) {
+      REQUIRE_FALSE (c.is_linked());
+      expired.push_back(c.id);
+      c.closed = std::chrono::steady_clock::now();
+    }
+  };
+
+  GIVEN ( "Six entries, of which the even ones are touched every 10 ms for 100 ms") {
+    auto start = std::chrono::steady_clock::now();
+    for (auto& c : conns) {
+      idle.insert(c);
+    }
+    REQUIRE (idle.size() == 6u);
+    idle.start();
+
+    chops::periodic_timer<> activity { ioc };
+    activity.start_timepoint_timer(10ms, [&idle, &conns] (std::error_code, auto) {
+        for (std::size_t i = 0u; i < conns.size(); i += 2u) {
+          idle.touch(conns[i]);
+        }
+        return true;
+      }, { .max_ticks = 10u }
+    );
+    chops::periodic_timer<> done { ioc };
+    done.start_duration_timer(110ms, [&idle] (std::error_code, auto) {
+        idle.stop();
+        return false;
+      }
+    );
+    ioc.run();
+
+    THEN ( "only the idle entries expire, in the order they were inserted" ) {
+      REQUIRE (expired == std::vector<int> { 1, 3, 5 });
+      REQUIRE (idle.size() == 3u);
+      REQUIRE (conns[1].closed - start >= 30ms);
+      REQUIRE (conns[1].closed - start < 45ms);
+    }
+    idle.clear();
+  }
+
+  GIVEN ( "Entries erased and re-inserted") {
+    idle.insert(conns[0]);
+    idle.insert(conns[1]);
+    idle.insert(conns[2]);
+    idle.erase(conns[1]);
+    idle.insert(conns[0]);
+
+    THEN ( "the size follows, and touching a new entry inserts it" ) {
+      REQUIRE (idle.size() == 2u);
+      REQUIRE_FALSE (conns[1].is_linked());
+      idle.touch(conns[3]);
+      REQUIRE (idle.size() == 3u);
+      idle.erase(conns[1]);
+      REQUIRE (idle.size() == 3u);
+    }
+    idle.clear();
+  }
+}
+
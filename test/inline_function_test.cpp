@@ -0,0 +1,61 @@
+/** @file
+ *
+ * @brief Test scenarios for @c inline_function.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory> // std::unique_ptr, std::make_unique, std::shared_ptr
+#include <type_traits> // std::is_constructible_v
+#include <utility> // std::move
+
+#include "timer/inline_function.hpp"
+
+using func_type = chops::inline_function<int (int), 32u>;
+
+// a wrapper is not copyable, and is never wrapped in itself as a function object
+static_assert(!std::is_constructible_v<func_type, func_type&>);
+static_assert(!std::is_constructible_v<func_type, const func_type&>);
+
+SCENARIO ( "An inline_function wraps a function object without allocating", "[inline_function]" ) {
+
+  GIVEN ( "An empty inline_function") {
+    func_type f;
+    REQUIRE_FALSE (f);
+
+    WHEN ( "A move-only lambda is stored" ) {
+      f.emplace([p = std::make_unique<int>(10)] (int i) { return *p + i; });
+      THEN ( "it is invoked through the wrapper") {
+        REQUIRE (f);
+        REQUIRE (f(5) == 15);
+      }
+      AND_WHEN ( "the wrapper is moved" ) {
+        func_type g { std::move(f) };
+        THEN ( "the function object is moved with it") {
+          REQUIRE_FALSE (f);
+          REQUIRE (g(1) == 11);
+        }
+      }
+    }
+    WHEN ( "A stored function object is replaced or reset" ) {
+      auto sp = std::make_shared<int>(1);
+      f.emplace([sp] (int i) { return *sp + i; });
+      REQUIRE (sp.use_count() == 2);
+      f = func_type([] (int i) { return i * 2; });
+      THEN ( "the previous function object is destroyed") {
+        REQUIRE (sp.use_count() == 1);
+        REQUIRE (f(4) == 8);
+        f.reset();
+        REQUIRE_FALSE (f);
+      }
+    }
+  } // end given
+}
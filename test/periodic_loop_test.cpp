@@ -0,0 +1,111 @@
+/** @file
+ *
+ * @brief Test scenarios for @c periodic_loop.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <system_error>
+
+#include "asio/error.hpp"
+
+#include "timer/periodic_loop.hpp"
+
+using namespace std::chrono_literals;
+
+constexpr int Expected = 9;
+
+template <typename Clock>
+void loop_util () {
+
+  chops::periodic_loop<Clock> loop;
+  int count = 0;
+  auto start = Clock::now();
+  typename Clock::duration total { };
+
+  loop.run(10ms, [&count, &total] (std::error_code err, typename Clock::duration elap) {
+      REQUIRE_FALSE (err);
+      total += elap;
+      return ++count < Expected;
+    }
+  );
+  auto elap = Clock::now() - start;
+
+  REQUIRE (count == Expected);
+  REQUIRE (elap >= Expected*10ms);
+  REQUIRE (elap < (Expected+5)*10ms);
+  REQUIRE (total >= Expected*10ms);
+}
+
+SCENARIO ( "A periodic loop invokes the callback on a timepoint grid", "[periodic_loop]" ) {
+
+  GIVEN ( "A loop on the steady clock") {
+    loop_util<std::chrono::steady_clock>();
+  }
+  GIVEN ( "A loop on the system clock") {
+    loop_util<std::chrono::system_clock>();
+  }
+  GIVEN ( "A loop on the high resolution clock") {
+    loop_util<std::chrono::high_resolution_clock>();
+  }
+
+  GIVEN ( "A loop with a callback that is slow once") {
+    chops::periodic_loop<> loop;
+    int count = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    WHEN ( "The first callback takes 35 ms of a 10 ms period" ) {
+      loop.run(10ms, [&count] (std::error_code, std::chrono::steady_clock::duration) {
+          if (count == 0) {
+            std::this_thread::sleep_for(35ms);
+          }
+          return ++count < Expected;
+        }
+      );
+      auto elap = std::chrono::steady_clock::now() - start;
+      THEN ( "the missed timepoints catch up without drift") {
+        REQUIRE (count == Expected);
+        REQUIRE (elap >= Expected*10ms);
+        REQUIRE (elap < (Expected+3)*10ms);
+      }
+    }
+  } // end given
+
+  GIVEN ( "A loop running on another thread") {
+    chops::periodic_loop<> loop;
+    int count = 0;
+    int cancelled = 0;
+
+    WHEN ( "The loop is cancelled" ) {
+      std::thread thr([&] {
+          loop.run(10ms, [&count, &cancelled] (std::error_code err, 
+                                               std::chrono::steady_clock::duration) {
+              cancelled += (err == asio::error::operation_aborted);
+              ++count;
+              return true;
+            }
+          );
+        }
+      );
+      std::this_thread::sleep_for(55ms);
+      loop.cancel();
+      thr.join();
+      THEN ( "the callback is notified and run returns") {
+        REQUIRE (cancelled == 1);
+        REQUIRE (count > 3);
+      }
+    }
+  } // end given
+}
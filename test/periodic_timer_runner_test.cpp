@@ -0,0 +1,184 @@
+/** @file
+ *
+ * @brief Test scenarios for @c periodic_timer_runner.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <cstdint> // std::uint64_t
+#include <system_error>
+
+#include "timer/periodic_timer.hpp"
+#include "timer/periodic_timer_runner.hpp"
+
+using namespace std::chrono_literals;
+
+constexpr int Expected = 9;
+
+int run_timer (chops::periodic_timer_runner& runner) {
+  int count = 0;
+  chops::periodic_timer<> timer { runner.get_io_context() };
+  timer.start_timepoint_timer(10ms,
+    [&count] (std::error_code, std::chrono::steady_clock::duration) {
+      return ++count < Expected;
+    }
+  );
+  runner.join();
+  return count;
+}
+
+SCENARIO ( "A runner owns the thread and io_context for periodic timers", "[runner]" ) {
+
+  GIVEN ( "A runner with default options") {
+    chops::periodic_timer_runner runner;
+    REQUIRE_FALSE (runner.is_running());
+
+    WHEN ( "It is started and a timer is run to completion" ) {
+      REQUIRE_FALSE (runner.start());
+      REQUIRE (runner.is_running());
+      REQUIRE (runner.start() == std::errc::operation_in_progress);
+      int count = run_timer(runner);
+      THEN ( "the thread finishes after the timer") {
+        REQUIRE (count == Expected);
+        REQUIRE_FALSE (runner.is_running());
+      }
+      AND_WHEN ( "it is started again" ) {
+        REQUIRE_FALSE (runner.start());
+        THEN ( "timers run again") {
+          REQUIRE (run_timer(runner) == Expected);
+        }
+      }
+    }
+  } // end given
+
+  GIVEN ( "A busy polling runner") {
+    chops::periodic_timer_runner runner { chops::runner_options { .mode = chops::run_mode::busy_poll } };
+
+    WHEN ( "A timer is run to completion" ) {
+      REQUIRE_FALSE (runner.start());
+      THEN ( "the thread finishes after the timer") {
+        REQUIRE (run_timer(runner) == Expected);
+        REQUIRE_FALSE (runner.is_running());
+      }
+    }
+  } // end given
+
+  GIVEN ( "Spinning runners with a watched timer") {
+
+    WHEN ( "A timer is run to completion in the spin and hybrid modes" ) {
+      for (auto mode : { chops::run_mode::spin, chops::run_mode::hybrid }) {
+        chops::periodic_timer_runner runner { chops::runner_options { .mode = mode } };
+        int count = 0;
+        chops::periodic_timer<> timer { runner.get_io_context() };
+        runner.watch(timer);
+        REQUIRE (timer.next_expiry() == std::chrono::steady_clock::time_point::max());
+        timer.start_timepoint_timer(10ms,
+          [&count] (std::error_code, std::chrono::steady_clock::duration) {
+            return ++count < Expected;
+          }
+        );
+        REQUIRE (timer.next_expiry() != std::chrono::steady_clock::time_point::max());
+        REQUIRE_FALSE (runner.start());
+        runner.join();
+        auto stats = runner.get_stats();
+        THEN ( "each expiry is dispatched and the statistics are reported") {
+          REQUIRE (count == Expected);
+          REQUIRE (stats.ticks == static_cast<std::uint64_t>(Expected));
+          REQUIRE (stats.max_lateness < 5ms);
+          REQUIRE (stats.mean_lateness() <= stats.max_lateness);
+          REQUIRE (stats.run_time >= (Expected-1)*10ms);
+          REQUIRE (stats.duty_cycle() > 0.0);
+          REQUIRE (stats.duty_cycle() < 0.5);
+        }
+      }
+    }
+  } // end given
+
+  GIVEN ( "A running runner with a timer that never finishes") {
+    chops::periodic_timer_runner runner;
+    REQUIRE_FALSE (runner.start());
+    chops::periodic_timer<> timer { runner.get_io_context() };
+    timer.start_duration_timer(10ms,
+      [] (std::error_code, std::chrono::steady_clock::duration) { return true; } );
+
+    WHEN ( "The runner is stopped" ) {
+      runner.stop();
+      THEN ( "the thread is joined") {
+        REQUIRE_FALSE (runner.is_running());
+      }
+    }
+  } // end given
+
+  GIVEN ( "Single-threaded runners with Asio locking disabled") {
+
+    WHEN ( "A timer started before the runner is run to completion" ) {
+      for (auto mode : { chops::run_mode::blocking, chops::run_mode::busy_poll }) {
+        chops::periodic_timer_runner runner { chops::runner_options { 
+            .concurrency_hint = chops::single_threaded_hint, .mode = mode } };
+        int count = 0;
+        chops::periodic_timer<> timer { runner.get_io_context() };
+        timer.start_timepoint_timer(10ms,
+          [&count, &timer] (std::error_code, std::chrono::steady_clock::duration) {
+            if (++count == 3) {
+              timer.set_period(5ms); // from within the callback
+            }
+            return count < Expected;
+          }
+        );
+        REQUIRE_FALSE (runner.start());
+        runner.join();
+        THEN ( "the thread finishes after the timer") {
+          REQUIRE (count == Expected);
+          REQUIRE_FALSE (runner.is_running());
+        }
+      }
+    }
+    WHEN ( "A single-threaded runner with a timer that never finishes is stopped" ) {
+      chops::periodic_timer_runner runner { chops::runner_options { 
+          .concurrency_hint = chops::single_threaded_hint } };
+      chops::periodic_timer<> timer { runner.get_io_context() };
+      timer.start_duration_timer(10ms,
+        [] (std::error_code, std::chrono::steady_clock::duration) { return true; } );
+      REQUIRE_FALSE (runner.start());
+      runner.stop();
+      THEN ( "the thread is joined") {
+        REQUIRE_FALSE (runner.is_running());
+      }
+    }
+  } // end given
+
+#ifdef __linux__
+  GIVEN ( "A runner pinned to the first CPU") {
+    chops::periodic_timer_runner runner { chops::runner_options { .cpu = 0 } };
+
+    WHEN ( "It is started" ) {
+      auto err = runner.start();
+      THEN ( "timers run on the pinned thread") {
+        REQUIRE_FALSE (err);
+        REQUIRE (run_timer(runner) == Expected);
+      }
+    }
+  } // end given
+
+  GIVEN ( "A runner with an invalid CPU") {
+    chops::periodic_timer_runner runner { chops::runner_options { .cpu = 1 << 20 } };
+
+    WHEN ( "It is started" ) {
+      auto err = runner.start();
+      THEN ( "an error is returned and the thread is not running") {
+        REQUIRE (err);
+        REQUIRE_FALSE (runner.is_running());
+      }
+    }
+  } // end given
+#endif
+}
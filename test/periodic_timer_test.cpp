@@ -19,9 +19,12 @@
 #include <chrono>
 #include <thread>
 #include <optional>
+#include <vector>
+#include <atomic>
 #include <system_error>
 
 #include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
 
 #include "timer/periodic_timer.hpp"
 
@@ -132,3 +135,715 @@ SCENARIO ( "A periodic timer can be instantiated on the high resolution clock",
 
 }
 
+
+SCENARIO ( "A periodic timer period can be changed while the timer is running", "[periodic_timer] [set_period]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A timepoint timer started with a 200 ms period") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    count = 0;
+
+    using clock = std::chrono::steady_clock;
+    // the first timepoint, when set_period was called, and the second callback
+    clock::time_point first_tp { clock::now() + 200ms };
+    clock::time_point set_time { };
+    clock::time_point second_time { };
+
+    // the first callback runs 30 ms past its timepoint before changing the period
+    auto change_period = [&] (chops::period_change pc) {
+      timer.start_timepoint_timer(200ms, first_tp,
+        [&timer, &set_time, &second_time, pc] (std::error_code err, clock::duration elap) { 
+          if (count == 0) {
+            std::this_thread::sleep_for(30ms);
+            set_time = clock::now();
+            timer.set_period(50ms, pc);
+          }
+          else if (count == 1) {
+            second_time = clock::now();
+          }
+          return lambda_util(err, elap);
+        }
+      );
+    };
+
+    WHEN ( "The period is changed to 50 ms in the first callback, preserving phase" ) {
+      change_period(chops::period_change::preserve_phase);
+
+      wait_util (200ms + (Expected+2)*50ms, wg, thr);
+
+      THEN ( "the next timepoint is one new period after the previous timepoint") {
+        REQUIRE (count == Expected);
+        REQUIRE (timer.get_period() == 50ms);
+        REQUIRE (second_time - first_tp >= 50ms);
+        REQUIRE (second_time - first_tp < 75ms);
+      }
+    }
+    WHEN ( "The period is changed to 50 ms in the first callback, re-anchoring" ) {
+      change_period(chops::period_change::re_anchor);
+
+      wait_util (200ms + (Expected+2)*50ms, wg, thr);
+
+      THEN ( "the next timepoint is one new period after the period change") {
+        REQUIRE (count == Expected);
+        REQUIRE (timer.get_period() == 50ms);
+        REQUIRE (second_time - set_time >= 50ms);
+        REQUIRE (second_time - set_time < 75ms);
+        REQUIRE (second_time - first_tp >= 80ms);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer can be paused and resumed", "[periodic_timer] [pause]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A timepoint timer with a 50 ms period") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    count = 0;
+    int aborted = 0;
+
+    timer.start_timepoint_timer(50ms,
+      [&timer, &aborted] (std::error_code err, std::chrono::steady_clock::duration elap) { 
+        if (err) {
+          ++aborted;
+        }
+        if (count == 2) {
+          timer.pause();
+        }
+        return lambda_util(err, elap);
+      }
+    );
+
+    WHEN ( "The timer is paused in the third callback and resumed later" ) {
+      std::this_thread::sleep_for(400ms);
+      int paused_count = count;
+      bool paused = timer.is_paused();
+      asio::post(ioc, [&timer] { timer.resume(); } );
+
+      wait_util ((Expected+2)*50ms, wg, thr);
+
+      THEN ( "no callbacks are invoked while paused and the callbacks continue after resume") {
+        REQUIRE (paused);
+        REQUIRE (paused_count == 3);
+        REQUIRE (aborted == 0);
+        REQUIRE (count == Expected);
+      }
+    }
+    WHEN ( "The timer is cancelled while paused" ) {
+      std::this_thread::sleep_for(400ms);
+      asio::post(ioc, [&timer] { timer.cancel(); } );
+
+      wait_util (100ms, wg, thr);
+
+      THEN ( "the callback is invoked with operation aborted") {
+        REQUIRE (aborted == 1);
+        REQUIRE (count == 4);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer can be cancelled and restarted from other threads", "[periodic_timer] [threads]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "An io_context run from four threads and a 1 ms timepoint timer") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::vector<std::thread> thrs;
+    for (int i = 0; i < 4; ++i) {
+      thrs.emplace_back([&ioc] () { ioc.run(); } );
+    }
+    std::atomic<int> ticks { 0 };
+    std::atomic<int> aborted { 0 };
+    constexpr int cycles = 50;
+
+    WHEN ( "The timer is repeatedly started and cancelled from the main thread" ) {
+      std::atomic<int> late_ticks { 0 };
+      std::atomic<bool> cancel_returned { false };
+      for (int i = 0; i < cycles; ++i) {
+        cancel_returned = false;
+        timer.start_timepoint_timer(1ms,
+          [&ticks, &aborted, &late_ticks, &cancel_returned] 
+                (std::error_code err, std::chrono::steady_clock::duration) {
+            if (err) {
+              ++aborted;
+              return false;
+            }
+            if (cancel_returned) {
+              ++late_ticks;
+            }
+            ++ticks;
+            return true;
+          }
+        );
+        std::this_thread::sleep_for(5ms);
+        timer.cancel();
+        cancel_returned = true;
+        std::this_thread::sleep_for(2ms);
+      }
+      wg.reset();
+      for (auto& thr : thrs) {
+        thr.join();
+      }
+
+      THEN ( "no tick callback starts after cancel returns, and each cancel is notified once") {
+        REQUIRE (late_ticks == 0);
+        REQUIRE (aborted == cycles);
+        REQUIRE (ticks > cycles);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer can be restarted from within its callback", "[periodic_timer] [restart]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A 10 ms timepoint timer") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    int new_ticks = 0;
+    int new_aborts = 0;
+
+    auto restart = [&timer, &new_ticks, &new_aborts] {
+      timer.start_duration_timer(10ms,
+        [&new_ticks, &new_aborts] (std::error_code err, std::chrono::steady_clock::duration) {
+          if (err) {
+            ++new_aborts;
+            return false;
+          }
+          return ++new_ticks < 3;
+        }
+      );
+    };
+
+    WHEN ( "The first callback restarts the timer and returns false" ) {
+      timer.start_timepoint_timer(10ms,
+        [&restart] (std::error_code err, std::chrono::steady_clock::duration) {
+          if (!err) {
+            restart();
+          }
+          return false;
+        }
+      );
+
+      wait_util (100ms, wg, thr);
+
+      THEN ( "the new timer runs to completion") {
+        REQUIRE (new_ticks == 3);
+        REQUIRE (new_aborts == 0);
+      }
+    }
+    WHEN ( "The timer is restarted from within the operation aborted notification" ) {
+      timer.start_timepoint_timer(10ms,
+        [&restart] (std::error_code err, std::chrono::steady_clock::duration) {
+          if (err) {
+            restart();
+            return false;
+          }
+          return true;
+        }
+      );
+      std::this_thread::sleep_for(25ms);
+      asio::post(ioc, [&timer] { timer.cancel(); } );
+
+      wait_util (100ms, wg, thr);
+
+      THEN ( "the new timer runs to completion") {
+        REQUIRE (new_ticks == 3);
+        REQUIRE (new_aborts == 0);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer callback can accept the expiration count", "[periodic_timer] [batch]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A timepoint timer with a 10 ms period") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    std::vector<std::size_t> expirations;
+
+    WHEN ( "The first callback stalls the thread for 55 ms" ) {
+      timer.start_timepoint_timer(10ms,
+        [&expirations] (std::error_code, std::chrono::steady_clock::duration, std::size_t n) {
+          if (expirations.empty()) {
+            std::this_thread::sleep_for(55ms);
+          }
+          expirations.push_back(n);
+          return expirations.size() < 3u;
+        }
+      );
+
+      wait_util (200ms, wg, thr);
+
+      THEN ( "the missed timepoints are reported in one invocation") {
+        REQUIRE (expirations.size() == 3u);
+        REQUIRE (expirations[0] == 1u);
+        REQUIRE (expirations[1] >= 5u);
+        REQUIRE (expirations[2] == 1u);
+      }
+    }
+  } // end given
+}
+
+struct tick_state {
+  explicit tick_state(int start) : ticks(start) { }
+  int ticks = 0;
+  std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+  std::size_t expirations = 0u;
+};
+
+SCENARIO ( "A periodic timer can hold an application state object", "[periodic_timer] [state]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A timer with an embedded state object") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<std::chrono::steady_clock, tick_state> timer {ioc, std::in_place, 10};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+
+    WHEN ( "The callback takes a state reference" ) {
+      timer.start_timepoint_timer(20ms,
+        [] (tick_state& st, std::error_code, std::chrono::steady_clock::duration elap) {
+          st.total += elap;
+          return ++st.ticks < Expected + 10;
+        }
+      );
+
+      wait_util ((Expected+2)*20ms, wg, thr);
+
+      THEN ( "the state is updated in place") {
+        REQUIRE (timer.get_state().ticks == Expected + 10);
+        REQUIRE (timer.get_state().total >= (Expected-1)*20ms);
+      }
+    }
+    WHEN ( "The callback takes a state reference and the expiration count" ) {
+      timer.start_duration_timer(20ms,
+        [] (tick_state& st, std::error_code, std::chrono::steady_clock::duration, std::size_t n) {
+          st.expirations += n;
+          return ++st.ticks < Expected + 10;
+        }
+      );
+
+      wait_util ((Expected+2)*25ms, wg, thr);
+
+      THEN ( "the state is updated in place") {
+        REQUIRE (timer.get_state().ticks == Expected + 10);
+        REQUIRE (timer.get_state().expirations == static_cast<std::size_t>(Expected));
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer can store the function object inline", "[periodic_timer] [inline_callback]" ) {
+
+  using namespace std::chrono_literals;
+  using timer_type = chops::periodic_timer<std::chrono::steady_clock, void, 64u>;
+
+  GIVEN ( "A container of timers with different function objects") {
+
+    asio::io_context ioc;
+    std::vector<timer_type> timers;
+    timers.emplace_back(ioc);
+    timers.emplace_back(ioc);
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+
+    int count = 0;
+    std::size_t expirations = 0u;
+    int aborted = 0;
+
+    WHEN ( "Both timers are started and one is cancelled" ) {
+      timers[0].start_duration_timer(20ms,
+        [&count] (std::error_code, std::chrono::steady_clock::duration) {
+          return ++count < Expected;
+        }
+      );
+      timers[1].start_timepoint_timer(10ms,
+        [&expirations, &aborted] (std::error_code err, std::chrono::steady_clock::duration, 
+                                  std::size_t n) {
+          aborted += (err == asio::error::operation_aborted);
+          expirations += n;
+          return true;
+        }
+      );
+      std::this_thread::sleep_for(55ms);
+      timers[1].cancel();
+
+      wait_util ((Expected+2)*20ms, wg, thr);
+
+      THEN ( "each timer invokes its own function object") {
+        REQUIRE (count == Expected);
+        REQUIRE (expirations >= 4u);
+        REQUIRE (aborted == 1);
+      }
+    }
+    WHEN ( "A timer is restarted with a new function object" ) {
+      timers[0].start_duration_timer(10ms,
+        [&aborted] (std::error_code, std::chrono::steady_clock::duration) {
+          ++aborted;
+          return true;
+        }
+      );
+      timers[0].start_duration_timer(20ms,
+        [&count] (std::error_code, std::chrono::steady_clock::duration) {
+          return ++count < Expected;
+        }
+      );
+
+      wait_util ((Expected+2)*20ms, wg, thr);
+
+      THEN ( "only the new function object is invoked") {
+        REQUIRE (count == Expected);
+        REQUIRE (aborted == 0);
+      }
+    }
+    WHEN ( "A timer is restarted from within its own callback" ) {
+      bool restarted = true;
+      timer_type& timer { timers[0] };
+      timer.start_duration_timer(10ms,
+        [&count, &restarted, &timer] (std::error_code, std::chrono::steady_clock::duration) {
+          restarted = timer.start_duration_timer(10ms,
+                        [] (std::error_code, std::chrono::steady_clock::duration) {
+                          return false;
+                        }
+                      );
+          return ++count < Expected;
+        }
+      );
+
+      wait_util ((Expected+2)*10ms, wg, thr);
+
+      THEN ( "the start is rejected and the running function object is kept") {
+        REQUIRE_FALSE (restarted);
+        REQUIRE (count == Expected);
+      }
+    }
+  } // end given
+}
+
+// rounds waits up to whole milliseconds, and counts the conversions
+std::atomic<int> rounded_waits { 0 };
+
+struct ms_rounding_traits {
+  using clock = std::chrono::steady_clock;
+  static clock::duration to_wait_duration(const clock::duration& d) {
+    ++rounded_waits;
+    return std::chrono::ceil<std::chrono::milliseconds>(d);
+  }
+  static clock::duration to_wait_duration(const clock::time_point& t) {
+    return to_wait_duration(t - clock::now());
+  }
+};
+
+SCENARIO ( "A periodic timer can use a concrete executor and custom wait traits", "[periodic_timer] [wait_traits]" ) {
+
+  using namespace std::chrono_literals;
+  using timer_type = chops::periodic_timer<std::chrono::steady_clock, void, 0u, 
+                                           ms_rounding_traits, asio::io_context::executor_type>;
+
+  GIVEN ( "A timer on an io_context executor with rounding wait traits") {
+
+    asio::io_context ioc;
+    timer_type timer {ioc.get_executor()};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    int count = 0;
+
+    WHEN ( "A timepoint timer is started" ) {
+      REQUIRE (timer.get_executor() == ioc.get_executor());
+      timer.start_timepoint_timer(10ms,
+        [&count] (std::error_code, std::chrono::steady_clock::duration) {
+          return ++count < Expected;
+        }
+      );
+
+      wait_util ((Expected+2)*10ms, wg, thr);
+
+      THEN ( "the wait traits are used for the waits") {
+        REQUIRE (count == Expected);
+        REQUIRE (rounded_waits > 0);
+      }
+    }
+  } // end given
+}
+
+// a clock that can be stepped by the test
+struct jumpy_clock {
+  using duration = std::chrono::steady_clock::duration;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<jumpy_clock>;
+  static constexpr bool is_steady = false;
+
+  static inline std::atomic<rep> offset { 0 };
+
+  static time_point now() noexcept {
+    return time_point(std::chrono::steady_clock::now().time_since_epoch() + duration(offset.load()));
+  }
+  static void step(duration d) {
+    offset += d.count();
+  }
+};
+
+struct jump_counts {
+  int ticks = 0;
+  int jumps = 0;
+  std::size_t max_expirations = 0u;
+};
+
+SCENARIO ( "A periodic timer re-anchors after a clock jump", "[periodic_timer] [clock_jump]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A 10 ms timepoint timer on a clock that is stepped") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<jumpy_clock> timer {ioc};
+    wk_guard wg { asio::make_work_guard(ioc) };
+
+    std::thread thr([&ioc] () { ioc.run(); } );
+    jump_counts counts;
+
+    auto func = [&counts] (std::error_code err, jumpy_clock::duration, std::size_t n) {
+      if (err == chops::timer_errc::clock_jump) {
+        ++counts.jumps;
+        return true;
+      }
+      counts.max_expirations = (n > counts.max_expirations) ? n : counts.max_expirations;
+      return ++counts.ticks < Expected;
+    };
+
+    WHEN ( "The clock jumps forward with detection enabled" ) {
+      timer.set_clock_jump_threshold(5ms);
+      timer.start_timepoint_timer(10ms, func);
+      std::this_thread::sleep_for(35ms);
+      jumpy_clock::step(1h);
+
+      wait_util ((Expected+4)*10ms, wg, thr);
+
+      THEN ( "the jump is reported once, without a burst of expirations") {
+        REQUIRE (counts.jumps == 1);
+        REQUIRE (counts.ticks == Expected);
+        REQUIRE (counts.max_expirations < 3u);
+      }
+    }
+    WHEN ( "The clock jumps backward and the timer is notified" ) {
+      timer.start_timepoint_timer(10ms, func);
+      std::this_thread::sleep_for(35ms);
+      jumpy_clock::step(-1h);
+      std::this_thread::sleep_for(20ms);
+      timer.clock_jumped();
+
+      wait_util ((Expected+4)*10ms, wg, thr);
+
+      THEN ( "the timer continues instead of waiting out the jump") {
+        REQUIRE (counts.jumps == 1);
+        REQUIRE (counts.ticks == Expected);
+        REQUIRE (std::error_code(chops::timer_errc::clock_jump).category() == chops::timer_category());
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer holds an average rate with a minimum gap", "[periodic_timer] [rate]" ) {
+
+  using namespace std::chrono_literals;
+
+  GIVEN ( "A 10 ms rate timer with a 3 ms minimum gap, and a callback taking 2 ms") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    std::vector<std::chrono::steady_clock::time_point> calls;
+
+    WHEN ( "The timer runs for 30 callbacks" ) {
+      auto start = std::chrono::steady_clock::now();
+      timer.start_rate_timer(10ms, 3ms,
+        [&calls] (std::error_code err, std::chrono::steady_clock::duration) {
+          REQUIRE_FALSE (err);
+          calls.push_back(std::chrono::steady_clock::now());
+          std::this_thread::sleep_for(2ms);
+          return calls.size() < 30u;
+        }
+      );
+      ioc.run();
+
+      THEN ( "the callbacks follow the timepoints, not the callback duration") {
+        REQUIRE (calls.size() == 30u);
+        REQUIRE (calls.back() - start >= 299ms);
+        REQUIRE (calls.back() - start < 315ms);
+      }
+    }
+
+    WHEN ( "The first callback stalls the thread for 55 ms" ) {
+      auto start = std::chrono::steady_clock::now();
+      timer.start_rate_timer(10ms, 3ms,
+        [&calls] (std::error_code, std::chrono::steady_clock::duration) {
+          calls.push_back(std::chrono::steady_clock::now());
+          if (calls.size() == 1u) {
+            std::this_thread::sleep_for(55ms);
+          }
+          return calls.size() < 20u;
+        }
+      );
+      ioc.run();
+
+      THEN ( "the missed timepoints are caught up, spaced by the minimum gap") {
+        REQUIRE (calls.size() == 20u);
+        for (std::size_t i = 1u; i < calls.size(); ++i) {
+          REQUIRE (calls[i] - calls[i-1] >= 3ms);
+        }
+        REQUIRE (calls[2] - calls[1] < 10ms);
+        REQUIRE (calls.back() - start >= 199ms);
+        REQUIRE (calls.back() - start < 215ms);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer callback can return the next delay", "[periodic_timer] [next_delay]" ) {
+
+  using namespace std::chrono_literals;
+  using dur_type = std::chrono::steady_clock::duration;
+
+  GIVEN ( "A duration timer with a doubling backoff") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<> timer {ioc};
+    std::vector<dur_type> elaps;
+
+    WHEN ( "The callback returns 10, 20 and 40 ms, then stops" ) {
+      timer.start_duration_timer(10ms,
+        [&elaps] (std::error_code, dur_type elap) -> std::optional<dur_type> {
+          elaps.push_back(elap);
+          if (elaps.size() == 4u) {
+            return std::nullopt;
+          }
+          return 10ms * (1 << (elaps.size() - 1u));
+        }
+      );
+      ioc.run();
+
+      THEN ( "each interval is the returned delay") {
+        REQUIRE (elaps.size() == 4u);
+        REQUIRE (elaps[1] >= 10ms);
+        REQUIRE (elaps[1] < 18ms);
+        REQUIRE (elaps[2] >= 20ms);
+        REQUIRE (elaps[2] < 28ms);
+        REQUIRE (elaps[3] >= 40ms);
+        REQUIRE (elaps[3] < 48ms);
+        REQUIRE (timer.get_period() == 10ms);
+      }
+    }
+  } // end given
+
+  GIVEN ( "An inline stored timepoint timer with a state object") {
+
+    asio::io_context ioc;
+    chops::periodic_timer<std::chrono::steady_clock, int, 64u> timer {ioc};
+
+    WHEN ( "The callback returns a delay of 5 ms times the tick count" ) {
+      auto start = std::chrono::steady_clock::now();
+      timer.start_timepoint_timer(5ms,
+        [] (int& ticks, std::error_code, dur_type) -> std::optional<dur_type> {
+          ++ticks;
+          return ticks < 4 ? std::optional<dur_type>(ticks * 5ms) : std::nullopt;
+        }
+      );
+      ioc.run();
+      auto elap = std::chrono::steady_clock::now() - start;
+
+      THEN ( "the timepoints are spaced by the returned delays") {
+        REQUIRE (timer.get_state() == 4);
+        REQUIRE (elap >= 35ms); // 5 + 5 + 10 + 15
+        REQUIRE (elap < 50ms);
+      }
+    }
+  } // end given
+}
+
+SCENARIO ( "A periodic timer evaluates its own stop conditions", "[periodic_timer] [start_options]" ) {
+
+  using namespace std::chrono_literals;
+  using dur_type = std::chrono::steady_clock::duration;
+
+  asio::io_context ioc;
+  chops::periodic_timer<> timer {ioc};
+  int ticks = 0;
+  auto tick_func = [&ticks] (std::error_code err, dur_type) {
+    REQUIRE_FALSE (err);
+    ++ticks;
+    return true;
+  };
+
+  GIVEN ( "A duration timer with a maximum tick count") {
+    timer.start_duration_timer(5ms, tick_func, { .max_ticks = 4u });
+    ioc.run();
+    THEN ( "the timer finishes after that many callbacks") {
+      REQUIRE (ticks == 4);
+      REQUIRE_FALSE (timer.is_running());
+    }
+  }
+
+  GIVEN ( "A one-shot timer") {
+    timer.start_timepoint_timer(5ms, tick_func, { .max_ticks = 1u });
+    ioc.run();
+    THEN ( "the callback is invoked once") {
+      REQUIRE (ticks == 1);
+    }
+  }
+
+  GIVEN ( "A timepoint timer with an end time point between two timepoints") {
+    auto start = std::chrono::steady_clock::now();
+    timer.start_timepoint_timer(10ms, start + 10ms, tick_func, { .until = start + 55ms });
+    ioc.run();
+    auto elap = std::chrono::steady_clock::now() - start;
+    THEN ( "the last timepoint before the end is invoked, and no final wait is armed") {
+      REQUIRE (ticks == 5);
+      REQUIRE (elap < 55ms);
+    }
+  }
+
+  GIVEN ( "A rate timer with an end time point before the first timepoint") {
+    auto start = std::chrono::steady_clock::now();
+    timer.start_rate_timer(10ms, 2ms, tick_func, { .until = start + 5ms });
+    ioc.run();
+    THEN ( "the timer never starts") {
+      REQUIRE (ticks == 0);
+      REQUIRE_FALSE (timer.is_running());
+    }
+  }
+}
+
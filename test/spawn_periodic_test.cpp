@@ -0,0 +1,163 @@
+/** @file
+ *
+ * @brief Test scenarios for @c spawn_periodic.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <optional>
+#include <system_error>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include "timer/spawn_periodic.hpp"
+
+using namespace std::chrono_literals;
+
+using wk_guard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+constexpr int num_timers = 100;
+constexpr int ticks_per_timer = 3;
+
+void spawn_util (asio::io_context& ioc, std::atomic<int>& ticks) {
+  for (int i = 0; i < num_timers; ++i) {
+    chops::spawn_periodic(ioc.get_executor(), 10ms,
+      [&ticks, count = 0] (std::error_code err, std::chrono::steady_clock::duration) mutable {
+        if (err) {
+          return false;
+        }
+        ++ticks;
+        return ++count < ticks_per_timer;
+      }
+    );
+  }
+}
+
+SCENARIO ( "Self-owning periodic timers can be spawned from a pool", "[spawn_periodic]" ) {
+
+  GIVEN ( "An io_context run from two threads") {
+
+    asio::io_context ioc;
+    wk_guard wg { asio::make_work_guard(ioc) };
+    std::vector<std::thread> thrs;
+    for (int i = 0; i < 2; ++i) {
+      thrs.emplace_back([&ioc] () { ioc.run(); } );
+    }
+    std::atomic<int> ticks { 0 };
+
+    WHEN ( "Timers are spawned, finish, and are spawned again" ) {
+      spawn_util(ioc, ticks);
+      std::this_thread::sleep_for(200ms);
+      auto capacity = chops::spawn_pool_capacity();
+      spawn_util(ioc, ticks);
+      std::this_thread::sleep_for(200ms);
+
+      THEN ( "every timer runs to completion and the pool slots are reused") {
+        REQUIRE (ticks == 2 * num_timers * ticks_per_timer);
+        REQUIRE (capacity >= num_timers);
+        REQUIRE (chops::spawn_pool_capacity() == capacity);
+      }
+    }
+    WHEN ( "A spawned timer is cancelled through its handle" ) {
+      std::atomic<int> aborted { 0 };
+      auto handle = chops::spawn_periodic(ioc.get_executor(), 10ms,
+        [&ticks, &aborted] (std::error_code err, std::chrono::steady_clock::duration) {
+          if (err) {
+            ++aborted;
+          }
+          ++ticks;
+          return true;
+        }
+      );
+      std::this_thread::sleep_for(50ms);
+      bool cancelled = handle.cancel();
+      std::this_thread::sleep_for(50ms);
+
+      THEN ( "the timer is notified, and a second cancel has no effect") {
+        REQUIRE (cancelled);
+        REQUIRE (aborted == 1);
+        REQUIRE_FALSE (handle.cancel());
+      }
+    }
+    WHEN ( "Spawned timers cancel other handles and spawn timers from their callbacks" ) {
+      std::atomic<int> aborted { 0 };
+      auto other = chops::spawn_periodic(ioc.get_executor(), 1ms,
+        [] (std::error_code err, std::chrono::steady_clock::duration) {
+          return !err;
+        }
+      );
+      std::vector<chops::spawned_timer<>> handles;
+      for (int i = 0; i < 10; ++i) {
+        handles.push_back(chops::spawn_periodic(ioc.get_executor(), 1ms,
+          [&ioc, &ticks, &aborted, other] (std::error_code err, std::chrono::steady_clock::duration) mutable {
+            if (err) {
+              ++aborted;
+              return false;
+            }
+            ++ticks;
+            other.cancel();
+            chops::spawn_periodic(ioc.get_executor(), 1ms,
+              [] (std::error_code, std::chrono::steady_clock::duration) { return false; }
+            );
+            return true;
+          }
+        ));
+      }
+      std::this_thread::sleep_for(20ms);
+      for (auto& handle : handles) {
+        handle.cancel();
+      }
+      std::this_thread::sleep_for(50ms);
+
+      THEN ( "the cancels don't deadlock, and each cancelled timer is notified once") {
+        REQUIRE (ticks > 0);
+        REQUIRE (aborted == 10);
+      }
+    }
+    WHEN ( "A spawned timer returns the delay to its next invocation" ) {
+      std::vector<std::chrono::steady_clock::duration> elaps;
+      auto handle = chops::spawn_periodic(ioc.get_executor(), 10ms,
+        [&ticks, &elaps, delay = 10ms] (std::error_code err, std::chrono::steady_clock::duration elap) mutable
+              -> std::optional<std::chrono::steady_clock::duration> {
+          if (err) {
+            return std::nullopt;
+          }
+          ++ticks;
+          elaps.push_back(elap);
+          delay += 10ms;
+          if (delay > 40ms) {
+            return std::nullopt;
+          }
+          return delay;
+        }
+      );
+      std::this_thread::sleep_for(200ms);
+
+      THEN ( "the delays are used, and an empty delay finishes the timer") {
+        REQUIRE (ticks == 4);
+        REQUIRE (elaps.size() == 4u);
+        REQUIRE (elaps[3] >= 40ms);
+        REQUIRE_FALSE (handle.cancel());
+      }
+    }
+    wg.reset();
+    for (auto& thr : thrs) {
+      thr.join();
+    }
+  } // end given
+}
@@ -0,0 +1,86 @@
+/** @file
+ *
+ * @brief Test scenarios for @c throttler.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <numeric> // std::accumulate
+#include <thread>
+#include <vector>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include "timer/throttler.hpp"
+
+using namespace std::chrono_literals;
+using time_point = std::chrono::steady_clock::time_point;
+
+void burst (chops::throttler<>& thr, std::chrono::milliseconds len, int& total) {
+  auto end = std::chrono::steady_clock::now() + len;
+  while (std::chrono::steady_clock::now() < end) {
+    thr.notify();
+    if (++total % 1000 == 0) {
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+}
+
+void throttle_util (chops::throttle_edge edge) {
+  asio::io_context ioc;
+  auto wg { asio::make_work_guard(ioc) };
+  std::thread run_thr([&ioc] () { ioc.run(); } );
+
+  std::vector<std::size_t> deliveries;
+  std::vector<time_point> times;
+  chops::throttler<> thr { ioc, 20ms, edge, [&deliveries, &times] (std::size_t events) {
+      deliveries.push_back(events);
+      times.push_back(std::chrono::steady_clock::now());
+    }
+  };
+
+  int total = 0;
+  auto start = std::chrono::steady_clock::now();
+  burst(thr, 100ms, total);
+  std::this_thread::sleep_for(60ms);
+  wg.reset();
+  run_thr.join();
+
+  REQUIRE (std::accumulate(deliveries.begin(), deliveries.end(), std::size_t(0u)) ==
+           static_cast<std::size_t>(total));
+  REQUIRE (deliveries.size() >= 4u);
+  REQUIRE (deliveries.size() <= 7u);
+  for (std::size_t i = 1u; i < times.size(); ++i) {
+    REQUIRE (times[i] - times[i-1] >= 15ms);
+  }
+  if (edge == chops::throttle_edge::leading) {
+    REQUIRE (times[0] - start < 10ms);
+  }
+  else {
+    REQUIRE (times[0] - start >= 20ms);
+  }
+  REQUIRE_FALSE (thr.is_pending());
+}
+
+SCENARIO ( "A throttler delivers events at most once per interval", "[throttler]" ) {
+
+  GIVEN ( "A leading edge throttler and a 100 ms burst of events") {
+    throttle_util(chops::throttle_edge::leading);
+  }
+  GIVEN ( "A trailing edge throttler and a 100 ms burst of events") {
+    throttle_util(chops::throttle_edge::trailing);
+  }
+}
+
@@ -0,0 +1,119 @@
+/** @file
+ *
+ * @brief Test scenarios for @c timeout_manager.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+
+#include "timer/periodic_timer.hpp"
+#include "timer/timeout_manager.hpp"
+
+using namespace std::chrono_literals;
+using time_point = std::chrono::steady_clock::time_point;
+
+// run the io_context until the timeout manager has been running for a while
+template <typename TM>
+void run_for (asio::io_context& ioc, TM& tm, std::chrono::milliseconds ms) {
+  chops::periodic_timer<> done { ioc };
+  done.start_duration_timer(ms, [&tm] (std::error_code, auto) {
+      tm.stop();
+      return false;
+    }
+  );
+  ioc.run();
+}
+
+SCENARIO ( "A timeout manager expires the registrations that are not removed", "[timeout_manager]" ) {
+
+  asio::io_context ioc;
+
+  GIVEN ( "100 registrations with timeouts from 1 to 100 ms, half of them removed") {
+    chops::timeout_manager<> tm { ioc, 5ms, 64u };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<chops::timeout_manager<>::handle> handles;
+    std::vector<time_point> fired(100u);
+    for (int i = 0; i < 100; ++i) {
+      handles.push_back(tm.add(std::chrono::milliseconds(i+1), [&fired, i] {
+          fired[i] = std::chrono::steady_clock::now();
+        }
+      ));
+    }
+    for (int i = 0; i < 100; i += 2) {
+      REQUIRE (tm.remove(handles[i]));
+    }
+    REQUIRE (tm.size() == 50u);
+    tm.start();
+    run_for(ioc, tm, 150ms);
+
+    THEN ( "only the others expire, each within two ticks after its deadline" ) {
+      REQUIRE (tm.size() == 0u);
+      for (int i = 0; i < 100; ++i) {
+        if (i % 2 == 0) {
+          REQUIRE (fired[i] == time_point());
+        }
+        else {
+          REQUIRE (fired[i] - start >= std::chrono::milliseconds(i+1));
+          REQUIRE (fired[i] - start < std::chrono::milliseconds(i+1) + 12ms);
+        }
+      }
+    }
+    AND_THEN ( "the handles of expired and removed registrations are stale" ) {
+      REQUIRE_FALSE (tm.remove(handles[0]));
+      REQUIRE_FALSE (tm.remove(handles[1]));
+      REQUIRE_FALSE (tm.remove(chops::timeout_manager<>::null_handle));
+    }
+  }
+
+  GIVEN ( "A timeout longer than the span of the wheel") {
+    chops::timeout_manager<> tm { ioc, 5ms, 8u };
+    auto start = std::chrono::steady_clock::now();
+    time_point fired { };
+    tm.add(100ms, [&fired] { fired = std::chrono::steady_clock::now(); });
+    tm.start();
+    run_for(ioc, tm, 130ms);
+
+    THEN ( "it expires after the full timeout" ) {
+      REQUIRE (fired - start >= 100ms);
+      REQUIRE (fired - start < 115ms);
+    }
+  }
+
+  GIVEN ( "A registration with a cancellation signal, and a timeout adding another") {
+    chops::timeout_manager<> tm { ioc, 5ms };
+    asio::cancellation_signal sig;
+    asio::cancellation_type received { asio::cancellation_type::none };
+    sig.slot().assign([&received] (asio::cancellation_type t) { received = t; });
+    tm.add(10ms, sig);
+    int chained = 0;
+    tm.add(10ms, [&tm, &chained] {
+        ++chained;
+        tm.add(10ms, [&chained] { ++chained; });
+      }
+    );
+    tm.start();
+    run_for(ioc, tm, 60ms);
+
+    THEN ( "the signal is emitted, and the chained registration expires" ) {
+      REQUIRE (received == asio::cancellation_type::terminal);
+      REQUIRE (chained == 2);
+      REQUIRE (tm.size() == 0u);
+    }
+  }
+}
+
@@ -0,0 +1,136 @@
+/** @file
+ *
+ * @brief Test scenarios for @c timerfd_timer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <system_error>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+
+#include "timer/timerfd_timer.hpp"
+
+using namespace std::chrono_literals;
+
+constexpr int Expected = 9;
+
+template <typename Clock>
+void timerfd_util () {
+  asio::io_context ioc;
+  chops::timerfd_timer<Clock> timer { ioc };
+  int count = 0;
+  typename Clock::duration total { };
+  auto start = Clock::now();
+
+  REQUIRE_FALSE (timer.start_timepoint_timer(10ms,
+    [&count, &total] (std::error_code err, typename Clock::duration elap) {
+      REQUIRE_FALSE (err);
+      total += elap;
+      return ++count < Expected;
+    })
+  );
+  ioc.run(); // returns when the callback returns false
+  auto elap = Clock::now() - start;
+
+  REQUIRE (count == Expected);
+  REQUIRE (elap >= Expected*10ms);
+  REQUIRE (elap < (Expected+5)*10ms);
+  REQUIRE (total >= Expected*10ms);
+}
+
+SCENARIO ( "A timerfd timer invokes the callback on a timepoint grid", "[timerfd_timer]" ) {
+
+  GIVEN ( "A timer on the steady clock") {
+    timerfd_util<std::chrono::steady_clock>();
+  }
+  GIVEN ( "A timer on the system clock") {
+    timerfd_util<std::chrono::system_clock>();
+  }
+
+  GIVEN ( "A timer with a batch callback that stalls once") {
+    asio::io_context ioc;
+    chops::timerfd_timer<> timer { ioc };
+    std::vector<std::size_t> expirations;
+
+    WHEN ( "The first callback stalls the thread for 55 ms" ) {
+      REQUIRE_FALSE (timer.start_timepoint_timer(10ms,
+        [&expirations] (std::error_code, std::chrono::steady_clock::duration, std::size_t n) {
+          if (expirations.empty()) {
+            std::this_thread::sleep_for(55ms);
+          }
+          expirations.push_back(n);
+          return expirations.size() < 3u;
+        })
+      );
+      ioc.run();
+      THEN ( "the kernel expiration count is reported in one invocation") {
+        REQUIRE (expirations.size() == 3u);
+        REQUIRE (expirations[0] == 1u);
+        REQUIRE (expirations[1] >= 5u);
+      }
+    }
+  } // end given
+
+  GIVEN ( "A running timer") {
+    asio::io_context ioc;
+    auto wg = asio::make_work_guard(ioc);
+    chops::timerfd_timer<> timer { ioc };
+    int count = 0;
+    int aborted = 0;
+    auto func = [&count, &aborted] (std::error_code err, std::chrono::steady_clock::duration) {
+      aborted += (err == asio::error::operation_aborted);
+      count += !err;
+      return true;
+    };
+
+    WHEN ( "It is cancelled from another thread through post" ) {
+      REQUIRE_FALSE (timer.start_timepoint_timer(10ms, func));
+      std::thread thr([&ioc] { ioc.run(); } );
+      std::this_thread::sleep_for(55ms);
+      asio::post(ioc, [&timer] { timer.cancel(); } );
+      std::this_thread::sleep_for(30ms);
+      wg.reset();
+      thr.join();
+      THEN ( "the callback is notified once and the timer stops") {
+        REQUIRE (aborted == 1);
+        REQUIRE (count >= 4);
+        REQUIRE (count <= 6);
+      }
+    }
+    WHEN ( "It is restarted" ) {
+      REQUIRE_FALSE (timer.start_timepoint_timer(10ms, func));
+      REQUIRE_FALSE (timer.start_timepoint_timer(10ms,
+        [&count] (std::error_code, std::chrono::steady_clock::duration) {
+          return ++count < Expected;
+        })
+      );
+      wg.reset();
+      ioc.run();
+      THEN ( "the first callback is notified and the second one runs") {
+        REQUIRE (aborted == 1);
+        REQUIRE (count == Expected);
+      }
+    }
+    WHEN ( "A zero duration is used" ) {
+      THEN ( "an error is returned") {
+        REQUIRE (timer.start_timepoint_timer(0ms, func) == std::errc::invalid_argument);
+      }
+    }
+  } // end given
+}
@@ -0,0 +1,87 @@
+/** @file
+ *
+ * @brief Test scenarios for @c token_bucket.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2017-2024 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include "timer/token_bucket.hpp"
+
+using namespace std::chrono_literals;
+
+SCENARIO ( "A token bucket allows bursts up to its capacity and refills over time", "[token_bucket]" ) {
+
+  asio::io_context ioc;
+  auto wg { asio::make_work_guard(ioc) };
+  chops::token_bucket<> bucket { ioc, 10u, 5u, 10ms };
+
+  GIVEN ( "A full bucket that is not refilled") {
+    THEN ( "the capacity can be acquired, and no more" ) {
+      REQUIRE (bucket.try_acquire(4u));
+      REQUIRE (bucket.try_acquire(6u));
+      REQUIRE_FALSE (bucket.try_acquire());
+      REQUIRE (bucket.available() == 0u);
+    }
+  }
+
+  GIVEN ( "A refilled bucket drained by four threads for 100 ms") {
+    std::thread run_thr([&ioc] () { ioc.run(); } );
+    bucket.start();
+    std::atomic<std::size_t> acquired { 0u };
+    std::vector<std::thread> thrs;
+    auto end = std::chrono::steady_clock::now() + 100ms;
+    for (int i = 0; i < 4; ++i) {
+      thrs.emplace_back([&bucket, &acquired, end] {
+          while (std::chrono::steady_clock::now() < end) {
+            if (bucket.try_acquire()) {
+              acquired.fetch_add(1u);
+            }
+          }
+        }
+      );
+    }
+    for (auto& t : thrs) {
+      t.join();
+    }
+    bucket.stop();
+    wg.reset();
+    run_thr.join();
+
+    THEN ( "the tokens taken are the capacity plus the refills" ) {
+      REQUIRE_FALSE (bucket.is_running());
+      REQUIRE (acquired.load() >= 10u + 8u*5u);
+      REQUIRE (acquired.load() <= 10u + 11u*5u);
+    }
+  }
+
+  GIVEN ( "An empty bucket left idle") {
+    bucket.try_acquire(10u);
+    std::thread run_thr([&ioc] () { ioc.run(); } );
+    bucket.start();
+    std::this_thread::sleep_for(60ms);
+    bucket.stop();
+    wg.reset();
+    run_thr.join();
+
+    THEN ( "the refills stop at the capacity" ) {
+      REQUIRE (bucket.available() == 10u);
+    }
+  }
+}
+